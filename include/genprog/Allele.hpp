@@ -10,9 +10,11 @@
 #define	ALLELE_HPP
 
 #include <sstream>
+#include <stdexcept>
 
 #include "oi-string.hpp"
 #include "genprog/genprog.hpp"
+#include "genprog/Chromocode.hpp"
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -234,6 +236,19 @@ public:
     virtual Allele *newCopy() const = 0;
 
 
+    /**
+     * Appends the binary representation of this Allele (and everything
+     * under it) to a Chromocode.  Only ConstAllele has an encoding so far;
+     * for the other types this throws until they supply one.
+     *
+     * @param code  The code we're building
+     *///--------------------------------------------------------------------
+    virtual void encode(Chromocode& /*code*/) const
+    {
+        throw std::logic_error("No chromocode encoding for " + toString());
+    }
+
+
     /**
      * Returns the sum of all the nodes in this Allele.
      *
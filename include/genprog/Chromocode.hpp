@@ -0,0 +1,188 @@
+/*\***********************************************************************\*//**
+ * MODULE: Chromocode.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef CHROMOCODE_HPP
+#define	CHROMOCODE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "genprog/genprog.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// Chromocode:
+// --------------------------------------------------------------------------
+/**
+ * Compact binary encoding of a chromosome (Allele tree) for MPI migration,
+ * checkpoints and Delphi.  The tree is written in prefix order as two
+ * streams:
+ *
+ *  - opcode stream: one tag byte per node (an Allele::Type), followed by a
+ *    wire opcode byte for FuncAlleles or by two varints (attribute index,
+ *    lag) for LookupAlleles
+ *  - constant stream: the raw Real value of each ConstAllele, so constants
+ *    survive the round trip at full precision (unlike toString())
+ *
+ * Wire opcodes are fixed by name in this module, independent of the order
+ * of the GPFunction library, so a saved code means the same thing from one
+ * build to the next.  Add new functions to the END of the opcode table and
+ * bump VERSION if an existing entry ever changes.
+ */
+// --------------------------------------------------------------------------
+class Chromocode
+{
+public:
+    static constexpr u_char  VERSION    = 1;        ///< Wire format version
+    static constexpr u_char  NO_OPCODE  = 0xFF;     ///< Opcode for a function we can't encode
+
+    /**
+     * Wire opcodes, by name, for code that switches on them.  These must
+     * match the opcode table in Chromocode.cpp.
+     */
+    enum Opcode : u_char
+    {
+        OP_ADD = 0, OP_SUB,  OP_MUL,  OP_DIV,
+        OP_INV,     OP_NEG,  OP_ABS,  OP_SQRT,
+        OP_CBRT,    OP_POW,  OP_SIN,  OP_COS,
+        OP_TAN,     OP_LOG,  OP_EXP,  OP_MIN,
+        OP_MAX,     OP_SQR,  OP_CUBE, OP_AVG,
+        NUM_OPCODES             ///< Keep this last
+    };
+
+    /**
+     * Wire opcode information for a GP function
+     */
+    struct OpInfo
+    {
+        const char *name_;      ///< GPFunction name as it appears in toString()
+        u_char      arity_;     ///< Number of arguments
+    };
+
+    class Reader;
+
+
+    /**
+     * Creates an empty code, ready to be written
+     *///--------------------------------------------------------------------
+    Chromocode()
+    : numNodes_(0)
+    { }
+
+
+    static u_char        opcodeOf(const std::string& funcName);
+    static const OpInfo& getOpInfo(u_char opcode);
+    static u_int         getNumOpcodes();
+
+    void    putConst(Real value);
+    void    putFunc(u_char opcode);
+    void    putLookup(u_int attrNdx, u_int lag);
+
+    std::string         pack()                          const;
+    static Chromocode   unpack(const std::string& bytes);
+    uint64_t            hash()                          const;
+
+    /**
+     * Returns the number of nodes (Alleles) in the code
+     *///--------------------------------------------------------------------
+    u_int getNodeCnt() const
+    {
+        return numNodes_;
+    }
+
+
+    /**
+     * Returns true if two codes represent the same tree, constants and all
+     *///--------------------------------------------------------------------
+    bool operator==(const Chromocode& that) const
+    {
+        return (ops_    == that.ops_)
+            && (consts_ == that.consts_);
+    }
+
+
+    /**
+     * Boost serialization for MPI transfers
+     *///--------------------------------------------------------------------
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned int version)
+    {
+        ar & numNodes_;
+        ar & ops_;
+        ar & consts_;
+    }
+
+
+private:
+    friend class Reader;
+
+    u_int               numNodes_;      ///< Node count
+    std::string         ops_;           ///< Opcode stream (tags, opcodes, lookup varints)
+    std::vector<Real>   consts_;        ///< Constant stream
+
+    void putVarint(u_int n);
+};
+
+
+// --------------------------------------------------------------------------
+// Chromocode::Reader:
+// --------------------------------------------------------------------------
+/**
+ * Walks a Chromocode in prefix order.  Allele decoders peek at the next tag,
+ * then take the node data that goes with it.
+ */
+// --------------------------------------------------------------------------
+class Chromocode::Reader
+{
+public:
+    /**
+     * Creates a reader positioned at the root of the tree
+     *
+     * @param code  The code to read (must outlive the reader)
+     *///--------------------------------------------------------------------
+    explicit Reader(const Chromocode& code)
+    : code_     (code),
+      opNdx_    (0),
+      constNdx_ (0)
+    { }
+
+    int     peekTag()                           const;
+    Real    getConst();
+    u_char  getFunc();
+    void    getLookup(u_int& attrNdx, u_int& lag);
+
+    /**
+     * Returns true once every node has been read
+     *///--------------------------------------------------------------------
+    bool atEnd() const
+    {
+        return opNdx_ >= code_.ops_.size();
+    }
+
+
+private:
+    friend class Chromocode;
+
+    const Chromocode&   code_;          ///< What we're reading
+    size_t              opNdx_;         ///< Position in opcode stream
+    size_t              constNdx_;      ///< Position in constant stream
+
+    void    takeTag(int tag);
+    u_int   getVarint();
+};
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* CHROMOCODE_HPP */
@@ -0,0 +1,255 @@
+/*\***********************************************************************\*//**
+ * MODULE: ColumnWindow.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef COLUMNWINDOW_HPP
+#define	COLUMNWINDOW_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "genprog/genprog.hpp"
+#include "util/ColumnBlock.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// ColumnWindow:
+// --------------------------------------------------------------------------
+/**
+ * A lag-aware view of the price data for evaluating a whole run of days at
+ * once.  The data stays in its per-attribute columns (oldest day first), so
+ * a LookupAllele's (attribute, offset) pair is just a shifted pointer into
+ * its column:
+ *
+ *      value(attr, offset, day) = stream(attr, offset)[day * getStride()]
+ *
+ * where day 0 is the first day of the range set by setRange().  The offset
+ * is the position in the sliding window of getWindowLen() days, with 0 the
+ * oldest day and getWindowLen()-1 the evaluation day itself, just as with
+ * AttrWindow.  setRange() resolves every (attribute, offset) pair up front,
+ * so a lookup never touches window indexing logic again: batched evaluation
+ * fetches the stream pointer once per node and streams through the days.
+ *
+ * The window never copies the data.  The columns must outlive it.
+ *
+ * The evaluator still builds an AttrWindow per thread, and LookupAllele
+ * still reads from that, so only the bench and the OpKernels calibration
+ * (Tuning) build ColumnWindows so far.
+ */
+// --------------------------------------------------------------------------
+class ColumnWindow
+{
+public:
+    ColumnWindow(const std::vector<const Real*>& cols,
+                 u_int                           numRows,
+                 u_int                           winLen,
+                 u_int                           targetNdx,
+                 u_int                           stride = 1);
+
+    ColumnWindow(const util::ColumnBlock& block,
+                 u_int                    winLen,
+                 u_int                    targetNdx);
+
+    void            setRange(u_int firstDay, u_int numDays);
+    void            setCursor(u_int day);
+
+    const Real*     stream(u_int attrNdx, u_int offset)                 const;
+    Real            lookup(u_int attrNdx, u_int offset)                 const;
+    Real            lookup(u_int attrNdx, u_int offset, u_int day)      const;
+
+    u_int           getNumAttrs()                                       const;
+    u_int           getNumRows()                                        const;
+    u_int           getWindowLen()                                      const;
+    u_int           getFirstDay()                                       const;
+    u_int           getNumDays()                                        const;
+    std::ptrdiff_t  getStride()                                         const;
+
+private:
+    std::vector<const Real*>    cols_;          ///< Attribute columns (target last)
+    u_int                       numRows_;       ///< Days of data in each column
+    u_int                       winLen_;        ///< Days in the sliding window
+    std::ptrdiff_t              stride_;        ///< Reals between consecutive days
+    u_int                       firstDay_;      ///< Evaluation day 0 as a row in the columns
+    u_int                       numDays_;       ///< Evaluation days in the range
+    u_int                       cursor_;        ///< Current day for scalar lookups
+    std::vector<const Real*>    views_;         ///< Resolved streams: [attr * winLen_ + offset]
+
+    u_int           viewNdx(u_int attrNdx, u_int offset)                const;
+};
+
+
+// --------------------------------------------------------------------------
+// stream:
+// --------------------------------------------------------------------------
+/**
+ * Returns the stream for an attribute at a window offset: element
+ * day*getStride() is the attribute's value for evaluation day 'day'.
+ *
+ * @param attrNdx   Attribute index (or Allele::TARGET)
+ * @param offset    Position in the sliding window (0 = oldest)
+ *
+ * @return          Pointer to the value for the first day in the range
+ */
+// --------------------------------------------------------------------------
+inline const Real* ColumnWindow::stream(u_int attrNdx, u_int offset) const
+{
+    return views_[viewNdx(attrNdx, offset)];
+}
+
+
+// --------------------------------------------------------------------------
+// lookup:
+// --------------------------------------------------------------------------
+/**
+ * Returns an attribute's value at a window offset for the current (cursor)
+ * day.  This is the scalar path for tree-walking evaluation.
+ *
+ * @param attrNdx   Attribute index (or Allele::TARGET)
+ * @param offset    Position in the sliding window (0 = oldest)
+ *
+ * @return          The attribute value
+ */
+// --------------------------------------------------------------------------
+inline Real ColumnWindow::lookup(u_int attrNdx, u_int offset) const
+{
+    return stream(attrNdx, offset)[cursor_ * stride_];
+}
+
+
+// --------------------------------------------------------------------------
+// lookup:
+// --------------------------------------------------------------------------
+/**
+ * Returns an attribute's value at a window offset for a specific day
+ *
+ * @param attrNdx   Attribute index (or Allele::TARGET)
+ * @param offset    Position in the sliding window (0 = oldest)
+ * @param day       Evaluation day, relative to the start of the range
+ *
+ * @return          The attribute value
+ */
+// --------------------------------------------------------------------------
+inline Real ColumnWindow::lookup(u_int attrNdx, u_int offset, u_int day) const
+{
+    return stream(attrNdx, offset)[day * stride_];
+}
+
+
+// --------------------------------------------------------------------------
+// setCursor:
+// --------------------------------------------------------------------------
+/**
+ * Selects the day that the two-argument lookup() uses
+ *
+ * @param day   Evaluation day, relative to the start of the range
+ */
+// --------------------------------------------------------------------------
+inline void ColumnWindow::setCursor(u_int day)
+{
+    cursor_ = day;
+}
+
+
+// --------------------------------------------------------------------------
+// getNumAttrs:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of attributes, not counting the target
+ */
+// --------------------------------------------------------------------------
+inline u_int ColumnWindow::getNumAttrs() const
+{
+    return cols_.size() - 1;
+}
+
+
+// --------------------------------------------------------------------------
+// getNumRows:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of days of data in each column
+ */
+// --------------------------------------------------------------------------
+inline u_int ColumnWindow::getNumRows() const
+{
+    return numRows_;
+}
+
+
+// --------------------------------------------------------------------------
+// getWindowLen:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of days in the sliding window
+ */
+// --------------------------------------------------------------------------
+inline u_int ColumnWindow::getWindowLen() const
+{
+    return winLen_;
+}
+
+
+// --------------------------------------------------------------------------
+// getFirstDay:
+// --------------------------------------------------------------------------
+/**
+ * Returns the column row of evaluation day 0
+ */
+// --------------------------------------------------------------------------
+inline u_int ColumnWindow::getFirstDay() const
+{
+    return firstDay_;
+}
+
+
+// --------------------------------------------------------------------------
+// getNumDays:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of evaluation days in the current range
+ */
+// --------------------------------------------------------------------------
+inline u_int ColumnWindow::getNumDays() const
+{
+    return numDays_;
+}
+
+
+// --------------------------------------------------------------------------
+// getStride:
+// --------------------------------------------------------------------------
+/**
+ * Returns the distance (in Reals) between consecutive days in a stream
+ */
+// --------------------------------------------------------------------------
+inline std::ptrdiff_t ColumnWindow::getStride() const
+{
+    return stride_;
+}
+
+
+// --------------------------------------------------------------------------
+// viewNdx:
+// --------------------------------------------------------------------------
+/**
+ * Maps an (attribute, offset) pair to its slot in views_
+ */
+// --------------------------------------------------------------------------
+inline u_int ColumnWindow::viewNdx(u_int attrNdx, u_int offset) const
+{
+    // TARGET is the largest u_int, so anything out of range goes to the target
+    u_int col = (attrNdx < cols_.size() - 1) ? attrNdx : (cols_.size() - 1);
+
+    return (col * winLen_) + offset;
+}
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* COLUMNWINDOW_HPP */
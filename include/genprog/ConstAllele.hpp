@@ -13,6 +13,7 @@
 #include <sstream>
 
 #include "genprog/Allele.hpp"
+#include "genprog/MemStats.hpp"
 
 namespace oi { namespace genprog {
 
@@ -34,7 +35,9 @@ public:
      *///--------------------------------------------------------------------
     ConstAllele(Real val = 0.0)
     : Value(val)
-    { }
+    {
+        MemStats::created(MemStats::CONST_ALLELE, sizeof(ConstAllele));
+    }
 
 
     /**
@@ -44,7 +47,18 @@ public:
      *///--------------------------------------------------------------------
     ConstAllele(const ConstAllele& that)
     : Value(that.Value)
-    { }
+    {
+        MemStats::created(MemStats::CONST_ALLELE, sizeof(ConstAllele));
+    }
+
+
+    /**
+     * Tear down the ConstAllele
+     *///--------------------------------------------------------------------
+    ~ConstAllele()
+    {
+        MemStats::destroyed(MemStats::CONST_ALLELE, sizeof(ConstAllele));
+    }
 
 #if defined(MEMPOOLS)
     static void * operator new(size_t size);
@@ -133,6 +147,17 @@ public:
         return new ConstAllele(*this);
     }
 
+
+    /**
+     * Appends the constant, at full precision, to a Chromocode
+     *
+     * @param code  The code we're building
+     *///--------------------------------------------------------------------
+    void encode(Chromocode& code) const override
+    {
+        code.putConst(Value);
+    }
+
     friend std::ostream& operator <<(std::ostream& out, const ConstAllele& allele);
 
 
@@ -0,0 +1,144 @@
+/*\***********************************************************************\*//**
+ * MODULE: EvoStats.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef EVOSTATS_HPP
+#define	EVOSTATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "genprog/genprog.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// EvoStats:
+// --------------------------------------------------------------------------
+/**
+ * Work counters for evolution runs: how many fitness scores, tree
+ * evaluations and node visits went into a run, and when the first
+ * individual reached a target fitness.  The benchmark mode divides these by
+ * the run's wall time to judge engine changes on real GP dynamics.
+ *
+ * Counting happens on the evaluation hot path, so each thread bumps its own
+ * counter block with plain (relaxed, unlocked) stores.  Only snapshot()
+ * walks all the blocks.  When a thread exits, its counts are folded into
+ * a process total and its block is freed, so short-lived threads don't
+ * pile up blocks.
+ */
+// --------------------------------------------------------------------------
+class EvoStats
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Totals across all threads since the last reset()
+     */
+    struct Snapshot
+    {
+        u_long  evaluations_;       ///< Fitness scores assigned
+        u_long  treeEvals_;         ///< Chromosome evaluations (one per window day)
+        u_long  nodesEvaluated_;    ///< Alleles visited by those evaluations
+        Real    bestFitness_;       ///< Best fitness scored
+        double  secsToTarget_;      ///< Seconds until the target fitness was reached (<0 if never)
+    };
+
+
+    static void     reset(Real targetFitness);
+    static Snapshot snapshot();
+
+
+    /**
+     * Counts one evaluation of a chromosome tree
+     *
+     * @param nodeCnt   Nodes in the tree
+     *///--------------------------------------------------------------------
+    static void countTreeEval(u_int nodeCnt)
+    {
+        Counters& mine = myCounters();
+
+        bump(mine.treeEvals_, 1);
+        bump(mine.nodesEvaluated_, nodeCnt);
+    }
+
+
+    /**
+     * Counts a fitness score and checks it against the target
+     *
+     * @param fitness   The individual's new fitness
+     *///--------------------------------------------------------------------
+    static void countEvaluation(Real fitness)
+    {
+        Counters& mine = myCounters();
+
+        bump(mine.evaluations_, 1);
+        if(fitness > mine.bestFitness_.load(std::memory_order_relaxed))
+        {
+            mine.bestFitness_.store(fitness, std::memory_order_relaxed);
+            if((fitness >= TargetFitness) && !mine.reachedNs_.load(std::memory_order_relaxed))
+            {
+                mine.reachedNs_.store(std::chrono::duration_cast<std::chrono::nanoseconds>
+                                          (Clock::now() - StartTime).count(),
+                                      std::memory_order_relaxed);
+            }
+        }
+    }
+
+
+private:
+    /**
+     * One thread's counters.  The block is registered on the thread's first
+     * count and retired when the thread exits.
+     */
+    struct Counters
+    {
+        std::atomic<u_long>     evaluations_;
+        std::atomic<u_long>     treeEvals_;
+        std::atomic<u_long>     nodesEvaluated_;
+        std::atomic<Real>       bestFitness_;
+        std::atomic<int64_t>    reachedNs_;         ///< Time to target since reset (0 = not yet)
+    };
+
+    /**
+     * Retires the thread's block when the thread exits
+     */
+    struct Retirer
+    {
+        ~Retirer();
+    };
+
+    static thread_local Counters       *Mine;           ///< This thread's block
+    static std::mutex                   RegistryLock;   ///< Guards Registry and Retired
+    static std::vector<Counters*>       Registry;       ///< Every live thread's block
+    static Snapshot                     Retired;        ///< Counts from threads that have exited
+    static Real                         TargetFitness;  ///< Fitness that counts as solved
+    static Clock::time_point            StartTime;      ///< When counting (re)started
+
+    static Counters& myCounters()
+    {
+        return Mine ? *Mine : addCounters();
+    }
+
+    static void bump(std::atomic<u_long>& n, u_long by)
+    {
+        // Only the owner thread writes, so no locked add
+        n.store(n.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    static Counters& addCounters();
+    static void      retireCounters();
+};
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* EVOSTATS_HPP */
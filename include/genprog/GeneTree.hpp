@@ -0,0 +1,220 @@
+/*\***********************************************************************\*//**
+ * MODULE: GeneTree.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef GENETREE_HPP
+#define	GENETREE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "genprog/genprog.hpp"
+#include "genprog/Allele.hpp"
+#include "genprog/Chromocode.hpp"
+#include "genprog/ColumnWindow.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// GeneTree:
+// --------------------------------------------------------------------------
+/**
+ * A chromosome as a closed set of tagged nodes, for evaluation.
+ *
+ * The Allele hierarchy only ever has three kinds of node, yet every
+ * getValue() goes through a vtable, and so does every newCopy() and
+ * toString().  A GeneTree holds the same tree as plain Nodes, each tagged
+ * with its Allele::Type, in one vector in prefix order.  A function's first
+ * argument comes right after it.  The second argument follows the first
+ * argument's subtree.
+ *
+ * Evaluation switches on the tag and then on the function's opcode.  Each
+ * case calls a template specialization of the operator, so the compiler can
+ * inline the whole walk.  There is no vtable pointer in any node, and
+ * copying a tree is one vector copy.
+ *
+ * A Node is 16 bytes.  Links are 32-bit indices into the tree's own node
+ * pool, and constants live in a side table, so there is no malloc header
+ * per node.  A ConstAllele, by contrast, is 32 bytes plus malloc overhead,
+ * and a FuncAllele is more.  Populations still hold Allele trees, though,
+ * so the saving shows up only in what the bench builds.
+ *
+ * Trees come from (and go back to) Chromocode, so an Individual converts
+ * with GeneTree(guy.encode()).  The functions have the same protected
+ * semantics as the OpKernels, so the scalar and batched paths agree.
+ *
+ * Nothing evaluates through a GeneTree yet.  The World still walks the
+ * Allele tree, and Individual::encode() throws while FuncAllele and
+ * LookupAllele have no encoding, so only the bench builds trees (and skips
+ * them when its pool can't be encoded).
+ */
+// --------------------------------------------------------------------------
+class GeneTree
+{
+public:
+    static constexpr uint32_t NO_NODE = UINT32_MAX;     ///< Parent of the root, etc.
+
+    /**
+     * One node of the tree.  A function's first argument is the node after
+     * it; data_ links to the second.
+     */
+    struct Node
+    {
+        uint32_t        parent_;        ///< Parent's index (NO_NODE for the root)
+        uint32_t        nodeCnt_;       ///< This node and everything under it
+        uint32_t        data_;          ///< Const: index into the constants
+                                        ///< Func:  second argument's index (NO_NODE if unary)
+                                        ///< Lookup: attribute index (or Allele::TARGET)
+        uint8_t         type_;          ///< Tag: an Allele::Type
+        uint8_t         opcode_;        ///< Func: Chromocode wire opcode
+        uint16_t        lag_;           ///< Lookup: offset into the attribute window
+    };
+
+    GeneTree();
+    GeneTree(const GeneTree& that);
+    explicit GeneTree(const Chromocode& code);
+    ~GeneTree();
+
+    GeneTree& operator=(const GeneTree& rhs);
+
+    Chromocode      encode()                                            const;
+
+    Real            getValue(const ColumnWindow& win)                   const;
+    const Real*     evalBlock(const ColumnWindow& win,
+                              u_int               firstDay,
+                              u_int               numDays,
+                              std::vector<Real>&  scratch)              const;
+
+    u_int           getNodeCnt()                                        const;
+    u_int           getHeight()                                         const;
+    u_int           getMaxLag()                                         const;
+    size_t          getBytes()                                          const;
+    const Node&     getNode(u_int ndx)                                  const;
+    Real            getConst(u_int ndx)                                 const;
+
+private:
+    std::vector<Node>   nodes_;         ///< The tree, in prefix order
+    std::vector<Real>   consts_;        ///< Constant values, by Node::data_
+    u_int               height_;        ///< Levels in the tree
+    u_int               maxLag_;        ///< Deepest lookup into the window
+
+    void            decode(Chromocode::Reader& code, uint32_t parent, u_int depth);
+    Real            valueAt(u_int ndx, const ColumnWindow& win)         const;
+    const Real*     blockAt(u_int               ndx,
+                            const ColumnWindow& win,
+                            u_int               firstDay,
+                            u_int               numDays,
+                            Real               *slot)                   const;
+};
+
+
+// --------------------------------------------------------------------------
+// getValue:
+// --------------------------------------------------------------------------
+/**
+ * Evaluates the tree for the window's current (cursor) day
+ *
+ * @param win   The price data
+ *
+ * @return      The tree's value
+ */
+// --------------------------------------------------------------------------
+inline Real GeneTree::getValue(const ColumnWindow& win) const
+{
+    return valueAt(0, win);
+}
+
+
+// --------------------------------------------------------------------------
+// getNodeCnt:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of nodes in the tree
+ */
+// --------------------------------------------------------------------------
+inline u_int GeneTree::getNodeCnt() const
+{
+    return nodes_.size();
+}
+
+
+// --------------------------------------------------------------------------
+// getHeight:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of levels in the tree (1 for a lone leaf)
+ */
+// --------------------------------------------------------------------------
+inline u_int GeneTree::getHeight() const
+{
+    return height_;
+}
+
+
+// --------------------------------------------------------------------------
+// getMaxLag:
+// --------------------------------------------------------------------------
+/**
+ * Returns the largest window offset any lookup uses.  The tree needs a
+ * window of at least getMaxLag()+1 days.
+ */
+// --------------------------------------------------------------------------
+inline u_int GeneTree::getMaxLag() const
+{
+    return maxLag_;
+}
+
+
+// --------------------------------------------------------------------------
+// getNode:
+// --------------------------------------------------------------------------
+/**
+ * Returns a node of the tree
+ *
+ * @param ndx   Position in prefix order (0 is the root)
+ */
+// --------------------------------------------------------------------------
+inline const GeneTree::Node& GeneTree::getNode(u_int ndx) const
+{
+    return nodes_[ndx];
+}
+
+
+// --------------------------------------------------------------------------
+// getConst:
+// --------------------------------------------------------------------------
+/**
+ * Returns the value of a constant node
+ *
+ * @param ndx   Position of a Const node in prefix order
+ */
+// --------------------------------------------------------------------------
+inline Real GeneTree::getConst(u_int ndx) const
+{
+    return consts_[nodes_[ndx].data_];
+}
+
+
+// --------------------------------------------------------------------------
+// getBytes:
+// --------------------------------------------------------------------------
+/**
+ * Returns the memory the tree takes up, nodes and constants included
+ */
+// --------------------------------------------------------------------------
+inline size_t GeneTree::getBytes() const
+{
+    return sizeof(GeneTree)
+         + (nodes_.size()  * sizeof(Node))
+         + (consts_.size() * sizeof(Real));
+}
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* GENETREE_HPP */
@@ -16,7 +16,10 @@
 #include <vector>
 
 #include "genprog/genprog.hpp"
+#include "genprog/EvoStats.hpp"
 #include "genprog/FuncAllele.hpp"
+#include "genprog/MemStats.hpp"
+#include "genprog/Telemetry.hpp"
 
 
 namespace oi { namespace genprog {
@@ -47,7 +50,7 @@ public:
     Individual(const Individual& that);
     Individual(const World& world);
     Individual(const World& world, const std::string& func);
-    ~Individual() { };
+    ~Individual() { MemStats::destroyed(MemStats::INDIVIDUAL, sizeof(Individual)); };
 
     friend std::ostream& operator <<(std::ostream& out, const Individual& rhs);
 
@@ -57,6 +60,7 @@ public:
 #endif
 
     const std::string toString()                                    const;
+    Chromocode      encode()                                        const;
     const FuncAllele& getChromosome()                               const;
 
     Real            getFitness()                                    const;
@@ -104,6 +108,27 @@ inline const std::string Individual::toString() const
 }
 
 
+// --------------------------------------------------------------------------
+// encode:
+// --------------------------------------------------------------------------
+/**
+ * Binary representation of the Individual's chromosome, for migration,
+ * checkpoints and Delphi.  Unlike toString(), constants keep their full
+ * precision.  Throws std::logic_error while some allele type in the tree
+ * has no encoding (see Allele::encode).
+ *
+ * @return      The chromosome's Chromocode
+ */
+// --------------------------------------------------------------------------
+inline Chromocode Individual::encode() const
+{
+    Chromocode code;
+
+    chromosome_.encode(code);
+    return code;
+}
+
+
 // --------------------------------------------------------------------------
 // getFitness:
 // --------------------------------------------------------------------------
@@ -167,6 +192,7 @@ inline u_int Individual::getChromoNodeCnt() const
 // --------------------------------------------------------------------------
 inline Real Individual::getChromoValue(const AttrWindow& win) const
 {
+    EvoStats::countTreeEval(chromosome_.getNodeCnt());
     return chromosome_.getValue(win);
 }
 
@@ -185,6 +211,7 @@ inline Real Individual::getChromoValue(const AttrWindow& win) const
 // --------------------------------------------------------------------------
 inline GPFuncResult Individual::execChromosome(const AttrWindow& win) const
 {
+    EvoStats::countTreeEval(chromosome_.getNodeCnt());
     return chromosome_.exec(win);
 }
 
@@ -244,6 +271,8 @@ inline bool Individual::canReproduce() const
 // --------------------------------------------------------------------------
 inline void Individual::mutate()
 {
+    Telemetry::PhaseTimer timer(Telemetry::MUTATION);
+
     chromosome_.mutate();
 }
 
@@ -260,6 +289,7 @@ inline void Individual::mutate()
 // --------------------------------------------------------------------------
 inline void Individual::setFitness(Real fitness)
 {
+    EvoStats::countEvaluation(fitness);
     fitness_ = fitness;
 }
 
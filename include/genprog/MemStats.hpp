@@ -0,0 +1,157 @@
+/*\***********************************************************************\*//**
+ * MODULE: MemStats.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef MEMSTATS_HPP
+#define	MEMSTATS_HPP
+
+#include <atomic>
+
+#include "genprog/genprog.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// MemStats:
+// --------------------------------------------------------------------------
+/**
+ * Allocation accounting for the GP objects that make up a population.  The
+ * Allele and Individual constructors and destructors report here, as do
+ * the MEMPOOLS pools, so we can see:
+ *
+ *  - live objects by type, and the bytes they take up
+ *  - the peak of those bytes (reset at the start of each job)
+ *  - outstanding blocks and the high-water mark of each memory pool
+ *
+ * Every Allele counts as a node; the subclasses also report their own type
+ * and size, so node bytes are only as complete as the subclasses that
+ * report.  The counters are process-wide relaxed atomics, each on its own
+ * cache line: allocation is already the expensive part.
+ */
+// --------------------------------------------------------------------------
+class MemStats
+{
+public:
+    enum Kind
+    {
+        ALLELE,                 ///< Every tree node, whatever its type (count only)
+        CONST_ALLELE,
+        FUNC_ALLELE,
+        LOOKUP_ALLELE,
+        INDIVIDUAL,
+        GENE_TREE,              ///< A GeneTree, with its nodes and constants
+        NUM_KINDS
+    };
+
+    enum Pool
+    {
+        CONST_ALLELE_POOL,
+        INDIVIDUAL_POOL,
+        NUM_POOLS
+    };
+
+
+    /**
+     * Counts a newly constructed object
+     *
+     * @param kind      What it is
+     * @param bytes     Its size (0 for ALLELE, which only counts nodes)
+     *///--------------------------------------------------------------------
+    static void created(Kind kind, size_t bytes = 0)
+    {
+        Live[kind].count_.fetch_add(1, std::memory_order_relaxed);
+        if(bytes)
+        {
+            size_t now = LiveBytes.bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            size_t top = PeakBytes.bytes_.load(std::memory_order_relaxed);
+
+            while((now > top) && !PeakBytes.bytes_.compare_exchange_weak(top, now, std::memory_order_relaxed))
+            {
+                // top now holds the latest peak
+            }
+        }
+    }
+
+
+    /**
+     * Counts a destroyed object
+     *
+     * @param kind      What it was
+     * @param bytes     Its size (0 for ALLELE)
+     *///--------------------------------------------------------------------
+    static void destroyed(Kind kind, size_t bytes = 0)
+    {
+        Live[kind].count_.fetch_sub(1, std::memory_order_relaxed);
+        if(bytes)
+        {
+            LiveBytes.bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+    }
+
+
+    /**
+     * Counts a block handed out by a memory pool
+     *///--------------------------------------------------------------------
+    static void poolAlloc(Pool pool)
+    {
+        long now = Pools[pool].count_.fetch_add(1, std::memory_order_relaxed) + 1;
+        long top = PoolHighs[pool].count_.load(std::memory_order_relaxed);
+
+        while((now > top) && !PoolHighs[pool].count_.compare_exchange_weak(top, now, std::memory_order_relaxed))
+        {
+            // top now holds the latest high-water mark
+        }
+    }
+
+
+    /**
+     * Counts a block returned to a memory pool
+     *///--------------------------------------------------------------------
+    static void poolFree(Pool pool)
+    {
+        Pools[pool].count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+
+    static long     getLive(Kind kind);
+    static size_t   getLiveBytes();
+    static size_t   getPeakBytes();
+    static long     getPoolBlocks(Pool pool);
+    static long     getPoolHighWater(Pool pool);
+    static void     resetPeak();
+
+private:
+    /**
+     * A counter on its own cache line
+     */
+    struct Counter
+    {
+        std::atomic<long>   count_;
+        char                pad_[64 - sizeof(std::atomic<long>)];
+    };
+
+    /**
+     * A byte total on its own cache line
+     */
+    struct ByteCounter
+    {
+        std::atomic<size_t> bytes_;
+        char                pad_[64 - sizeof(std::atomic<size_t>)];
+    };
+
+    static Counter      Live[NUM_KINDS];        ///< Live objects by kind
+    static Counter      Pools[NUM_POOLS];       ///< Outstanding pool blocks
+    static Counter      PoolHighs[NUM_POOLS];   ///< Pool high-water marks
+    static ByteCounter  LiveBytes;              ///< Bytes in live objects
+    static ByteCounter  PeakBytes;              ///< Most live bytes since resetPeak()
+};
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* MEMSTATS_HPP */
@@ -0,0 +1,86 @@
+/*\***********************************************************************\*//**
+ * MODULE: OpKernels.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef OPKERNELS_HPP
+#define	OPKERNELS_HPP
+
+#include "genprog/genprog.hpp"
+#include "util/HardwareProbe.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// OpKernels:
+// --------------------------------------------------------------------------
+/**
+ * Batched GPFunction kernels, indexed by Chromocode wire opcode.  A kernel
+ * applies its function to a whole block of evaluation days at once:
+ *
+ *      out[d] = f(x[d], y[d])      for d in [0, n)
+ *
+ * where y is ignored by unary functions.  out may be x or y, so a tree walk
+ * can work in place.
+ *
+ * The kernel set is compiled for the build's baseline (SSE2 on x86-64) and
+ * again for AVX2 and AVX-512.  At startup select() picks the widest set the
+ * CPU supports, so one binary uses the best vectors each node has.  No set
+ * uses FMA (OpKernels.cpp builds with -ffp-contract=off), and the
+ * transcendentals all go to the same libm, so every level gives
+ * bit-identical results.
+ */
+// --------------------------------------------------------------------------
+class OpKernels
+{
+public:
+    typedef util::HardwareProbe::SIMD SIMD;
+    typedef void (*Kernel)(Real *out, const Real *x, const Real *y, u_int n);
+
+    static Kernel   get(u_char opcode);
+    static SIMD     getLevel();
+    static SIMD     select(SIMD maxLevel);
+
+private:
+    static const Kernel    *Table;      ///< Selected kernels, by opcode
+    static SIMD             Level;      ///< Selected SIMD level
+};
+
+
+// --------------------------------------------------------------------------
+// get:
+// --------------------------------------------------------------------------
+/**
+ * Returns the kernel for a GP function
+ *
+ * @param opcode    The function's Chromocode wire opcode
+ *
+ * @return          The kernel at the selected SIMD level
+ */
+// --------------------------------------------------------------------------
+inline OpKernels::Kernel OpKernels::get(u_char opcode)
+{
+    return Table[opcode];
+}
+
+
+// --------------------------------------------------------------------------
+// getLevel:
+// --------------------------------------------------------------------------
+/**
+ * Returns the SIMD level of the selected kernels
+ */
+// --------------------------------------------------------------------------
+inline OpKernels::SIMD OpKernels::getLevel()
+{
+    return Level;
+}
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* OPKERNELS_HPP */
@@ -0,0 +1,57 @@
+/*\***********************************************************************\*//**
+ * MODULE: PopulationFile.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef POPULATIONFILE_HPP
+#define	POPULATIONFILE_HPP
+
+#include <string>
+#include <vector>
+
+#include "genprog/Chromocode.hpp"
+#include "genprog/Individual.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// PopulationFile:
+// --------------------------------------------------------------------------
+/**
+ * Saves a job's final population so that tomorrow's run of the same job can
+ * warm-start from it instead of from a random population.  Individuals are
+ * stored as packed Chromocodes with their last fitness score.
+ *
+ * Loading gives back the saved chromosomes, not Individuals: rebuilding an
+ * Individual from its Chromocode needs every allele type to decode itself.
+ * Since the data window moves one day between runs, the ancestors come
+ * back UNSCORED, and the World must re-score them on the new window.
+ * Loading thins the saved population to keep it diverse: exact duplicates go,
+ * half the slots go to the fittest, and the rest are spread evenly across
+ * the remaining fitness ranks.
+ *
+ * No job saves or loads a population yet, and there is no option for it:
+ * the World has no hook for seeding its first generation with ancestors.
+ */
+// --------------------------------------------------------------------------
+class PopulationFile
+{
+public:
+    static std::string  pathFor(const std::string& jobName);
+
+    static size_t       save(const std::string&     path,
+                             const Individual_Vp&   population);
+
+    static size_t       load(const std::string&         path,
+                             size_t                     maxCount,
+                             std::vector<Chromocode>&   ancestors);
+};
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* POPULATIONFILE_HPP */
@@ -0,0 +1,236 @@
+/*\***********************************************************************\*//**
+ * MODULE: Telemetry.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef TELEMETRY_HPP
+#define	TELEMETRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <time.h>
+
+#include "genprog/genprog.hpp"
+#include "util/PerfCounters.hpp"
+
+namespace oi { namespace genprog {
+
+class Individual;
+
+
+// --------------------------------------------------------------------------
+// Telemetry:
+// --------------------------------------------------------------------------
+/**
+ * Per-generation performance metrics for one job's evolution.  Each
+ * generation gets a row with:
+ *
+ *  - wall and CPU time for selection, reproduction, mutation and evaluation
+ *  - fitness evaluations and evaluations/sec
+ *  - mean, max and distribution of tree size
+ *  - any extra gauges the engine reports (allocations, cache hit rates, ...)
+ *
+ * After every generation the row is exported as a Prometheus text-format
+ * file (for node_exporter's textfile collector), replaced atomically, and
+ * optionally appended to a per-job CSV.  Series carry a sibyl_job label,
+ * since the scraper owns the job label.  The file goes away with the
+ * Telemetry, so finished jobs don't linger in the collector.
+ *
+ * The job activates its Telemetry for the process; the engine times its
+ * phases with PhaseTimer scopes and calls endGeneration() once per
+ * generation.  With no Telemetry active, a PhaseTimer costs one atomic load.
+ * Nested timers are exclusive: a mutation timed inside a reproduction
+ * counts as mutation only.
+ *
+ * So far only Individual times anything (mating and mutation).  Selection
+ * and evaluation happen in the World's generation loop, which has no timers
+ * and doesn't call endGeneration() yet, so no rows are exported (and the
+ * per-job PHASE line shows only reproduction and mutation) until it does.
+ *
+ * With setPerf(true), the timers also take the thread's hardware counters
+ * (cycles, instructions, LLC and branch misses) for each phase.  That costs
+ * a few syscalls per timer, so it is for profiling runs.
+ */
+// --------------------------------------------------------------------------
+class Telemetry
+{
+public:
+    static constexpr int NUM_SIZE_BUCKETS = 12;     ///< Tree sizes up to 1, 2, 4, ... 1024, +Inf
+
+    enum Phase
+    {
+        SELECTION,
+        REPRODUCTION,
+        MUTATION,
+        EVALUATION,
+        NUM_PHASES
+    };
+
+
+    /**
+     * Times its scope into a phase of the active Telemetry
+     */
+    class PhaseTimer
+    {
+    public:
+        explicit PhaseTimer(Phase phase);
+        ~PhaseTimer();
+
+        PhaseTimer(const PhaseTimer& that) = delete;                ///< DISABLED!
+        PhaseTimer & operator=(const PhaseTimer& rhs) = delete;     ///< DISABLED!
+
+    private:
+        Telemetry      *telemetry_;     ///< Active telemetry, or NULL
+        Phase           phase_;         ///< Phase we're timing
+        PhaseTimer     *parent_;        ///< Enclosing timer on this thread
+        int64_t         wallStart_;     ///< Wall clock at start (ns)
+        int64_t         cpuStart_;      ///< Thread CPU clock at start (ns)
+        int64_t         childWall_;     ///< Wall time taken by nested timers
+        int64_t         childCPU_;      ///< CPU time taken by nested timers
+        bool            isPerf_;        ///< Taking hardware counters?
+
+        util::PerfCounters::Sample  perfStart_;     ///< Counters at start
+        util::PerfCounters::Sample  childPerf_;     ///< Counts taken by nested timers
+    };
+
+
+    /**
+     * Makes a Telemetry the process's active one for its scope
+     */
+    class Active
+    {
+    public:
+        explicit Active(Telemetry& telemetry);
+        ~Active();
+
+        Active(const Active& that) = delete;                        ///< DISABLED!
+        Active & operator=(const Active& rhs) = delete;             ///< DISABLED!
+
+    private:
+        Telemetry      *previous_;      ///< Telemetry active before us
+    };
+
+
+    Telemetry(const std::string& jobName,
+              const std::string& csvPath = "");
+    ~Telemetry();
+
+    Telemetry(const Telemetry& that) = delete;                      ///< DISABLED!
+    Telemetry & operator=(const Telemetry& rhs) = delete;           ///< DISABLED!
+
+    static Telemetry*   getActive();
+    static std::string  pathFor(const std::string& jobName);
+    static const char*  getPhaseName(Phase phase);
+    static void         setPerf(bool yesNo);
+    static bool         isPerf();
+
+    void                setGauge(const std::string& name, double value);
+    void                endGeneration(const std::vector<std::unique_ptr<Individual>>& population);
+    void                writePrometheus(const std::string& path)        const;
+
+    u_int               getNumGenerations()                             const;
+    double              getPhaseCPUSecs(Phase phase)                    const;
+    util::PerfCounters::Sample getPhasePerf(Phase phase)                const;
+
+    friend std::ostream& operator <<(std::ostream& out, const Telemetry& rhs);
+
+private:
+    /**
+     * One generation's metrics
+     */
+    struct Row
+    {
+        u_int                           generation_;                ///< Generation number
+        double                          wallSecs_;                  ///< Whole generation
+        double                          phaseWall_[NUM_PHASES];     ///< Wall secs by phase
+        double                          phaseCPU_[NUM_PHASES];      ///< CPU secs by phase (all threads)
+        u_long                          evaluations_;               ///< Fitness scores assigned
+        double                          meanSize_;                  ///< Mean tree size (nodes)
+        u_int                           maxSize_;                   ///< Biggest tree
+        u_int                           sizeHist_[NUM_SIZE_BUCKETS];///< Trees per size bucket
+        std::map<std::string, double>   gauges_;                    ///< Engine extras
+    };
+
+    std::string                 jobName_;               ///< Job (world) name, e.g., SPY.close.5
+    std::string                 promPath_;              ///< Prometheus text file
+    std::ofstream               csv_;                   ///< Per-generation CSV (if wanted)
+    std::atomic<int64_t>        phaseWall_[NUM_PHASES]; ///< Wall ns by phase, this generation
+    std::atomic<int64_t>        phaseCPU_[NUM_PHASES];  ///< CPU ns by phase, this generation
+    double                      totalWall_[NUM_PHASES]; ///< Wall secs by phase, whole job
+    double                      totalCPU_[NUM_PHASES];  ///< CPU secs by phase, whole job
+    int64_t                     genStart_;              ///< Wall clock when the generation began
+    u_long                      evalsAtStart_;          ///< EvoStats evaluations when it began
+    std::map<std::string, double> gauges_;              ///< Gauges for this generation
+    std::atomic<uint64_t>       phasePerf_[NUM_PHASES]
+                                          [util::PerfCounters::NUM_EVENTS];  ///< Hardware counts by phase, whole job
+    Row                         last_;                  ///< The latest finished generation
+
+    static std::atomic<Telemetry*>  ActiveTelemetry;    ///< The process's active telemetry
+    static std::atomic<bool>        PerfEnabled;        ///< Timers take hardware counters
+
+    void    writeCSV(const Row& row);
+
+    static int64_t nowNs(clockid_t clock)
+    {
+        struct timespec ts;
+
+        clock_gettime(clock, &ts);
+        return (ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+    }
+};
+
+
+// --------------------------------------------------------------------------
+// getActive:
+// --------------------------------------------------------------------------
+/**
+ * Returns the process's active Telemetry
+ *
+ * @return      The active Telemetry, or NULL if no job is collecting metrics
+ */
+// --------------------------------------------------------------------------
+inline Telemetry* Telemetry::getActive()
+{
+    return ActiveTelemetry.load(std::memory_order_acquire);
+}
+
+
+// --------------------------------------------------------------------------
+// isPerf:
+// --------------------------------------------------------------------------
+/**
+ * Returns true if phase timers take hardware counters
+ */
+// --------------------------------------------------------------------------
+inline bool Telemetry::isPerf()
+{
+    return PerfEnabled.load(std::memory_order_relaxed);
+}
+
+
+// --------------------------------------------------------------------------
+// getNumGenerations:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of generations recorded so far
+ */
+// --------------------------------------------------------------------------
+inline u_int Telemetry::getNumGenerations() const
+{
+    return last_.generation_;
+}
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* TELEMETRY_HPP */
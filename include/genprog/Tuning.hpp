@@ -0,0 +1,114 @@
+/*\***********************************************************************\*//**
+ * MODULE: Tuning.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef TUNING_HPP
+#define	TUNING_HPP
+
+#include <ostream>
+#include <string>
+
+#include <boost/program_options.hpp>
+
+#include "genprog/genprog.hpp"
+#include "util/HardwareProbe.hpp"
+
+namespace oi { namespace genprog {
+
+
+// --------------------------------------------------------------------------
+// Tuning:
+// --------------------------------------------------------------------------
+/**
+ * How the evaluation engine should run on this node:
+ *
+ *  - threads:    evaluation threads
+ *  - block-size: evaluation days handled per batch (sized for the caches)
+ *  - islands:    sub-populations (one per NUMA node keeps each island's
+ *                individuals in its own node's memory)
+ *
+ * `sibyl --system` probes the hardware, calibrates the engine on synthetic
+ * data and saves the result to a per-host tuning file.  At startup the
+ * tuning file is read along with the config file, as a [tuning] section,
+ * so the config file or --set can still override it.  The World reads its
+ * settings from get().
+ */
+// --------------------------------------------------------------------------
+class Tuning
+{
+public:
+    Tuning(u_int threads   = 0,
+           u_int blockSize = 256,
+           u_int islands   = 1);
+
+    static const Tuning&    get();
+    static std::string      pathFor();
+    static Tuning           calibrate(const util::HardwareProbe::Info& hw, std::ostream& out);
+
+    static boost::program_options::options_description getOptionsDescr();
+    static void             setOptions(const boost::program_options::variables_map& cfg);
+
+    bool                    save(const std::string& path)           const;
+
+    u_int                   getThreads()                            const;
+    u_int                   getBlockSize()                          const;
+    u_int                   getIslands()                            const;
+
+    friend std::ostream& operator <<(std::ostream& out, const Tuning& rhs);
+
+private:
+    u_int           threads_;           ///< Evaluation threads
+    u_int           blockSize_;         ///< Evaluation days per batch
+    u_int           islands_;           ///< Sub-populations
+    std::string     simd_;              ///< SIMD level we tuned with
+
+    static Tuning   Current;            ///< This node's tuning
+};
+
+
+// --------------------------------------------------------------------------
+// getThreads:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of evaluation threads
+ */
+// --------------------------------------------------------------------------
+inline u_int Tuning::getThreads() const
+{
+    return threads_;
+}
+
+
+// --------------------------------------------------------------------------
+// getBlockSize:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of evaluation days to handle per batch
+ */
+// --------------------------------------------------------------------------
+inline u_int Tuning::getBlockSize() const
+{
+    return blockSize_;
+}
+
+
+// --------------------------------------------------------------------------
+// getIslands:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of sub-populations
+ */
+// --------------------------------------------------------------------------
+inline u_int Tuning::getIslands() const
+{
+    return islands_;
+}
+
+
+} } // ns{ oi::genprog }
+
+#endif	/* TUNING_HPP */
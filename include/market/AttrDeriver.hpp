@@ -0,0 +1,423 @@
+/*\***********************************************************************\*//**
+ * MODULE: AttrDeriver.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef ATTRDERIVER_HPP
+#define	ATTRDERIVER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "ostrich.hpp"
+
+namespace oi { namespace market {
+
+
+// --------------------------------------------------------------------------
+// AttrDeriver:
+// --------------------------------------------------------------------------
+/**
+ * Derives indicator attributes (moving averages, volatility, RSI, returns)
+ * from a security's base price columns.  There is one deriver per security,
+ * and its columns are shared by every ProgJob on that security, so adding an
+ * indicator costs one pass over the price history, not one per world.
+ *
+ * The moving sums come from running prefix sums kept per base column, so an
+ * N-day window costs the same as a 2-day window, and all the windows on the
+ * same base share one set of sums.  When new days arrive, extend() computes
+ * only the new rows, picking up the prefix sums and the EMA/RSI state where
+ * the last call left them.
+ *
+ * Indicators are specified as "[kind:]attr:period[,period...]", with several
+ * specs separated by ';' or spaces.  Without a kind, we get simple moving
+ * averages, so the original --moving-avg syntax ("close:50,200") still works.
+ *
+ *      sma     Simple moving average                   close.sma50
+ *      ema     Exponential moving average              close.ema12
+ *      std     Rolling (population) standard deviation close.std20
+ *      rsi     Wilder's relative strength index        close.rsi14
+ *      ret     Return over period days                 close.ret5
+ *
+ * Rows before a full window is available use what is there (a partial
+ * window), so derived columns never hold NaNs for the GP to trip over.
+ *
+ * Not yet wired in: --moving-avg still goes to PriceDataPack::addMovingAvg(),
+ * which computes its own simple averages.  Only the bench derives columns
+ * here.
+ */
+// --------------------------------------------------------------------------
+class AttrDeriver
+{
+public:
+    enum Kind
+    {
+        SMA,
+        EMA,
+        STD,
+        RSI,
+        RET
+    };
+
+
+    /**
+     * Creates a deriver with no indicators
+     *///--------------------------------------------------------------------
+    AttrDeriver()
+    : numRows_(0)
+    { }
+
+
+    /**
+     * Adds the indicators in a spec string
+     *
+     * @param spec      Indicator spec(s), e.g., "close:50,200; rsi:close:14"
+     * @param baseNames Names of the base attribute columns
+     *
+     * @return          The number of indicators added
+     *///--------------------------------------------------------------------
+    size_t addSpec(const std::string& spec, const std::vector<std::string>& baseNames)
+    {
+        static const char* KindNames[] = { "sma", "ema", "std", "rsi", "ret" };
+
+        std::vector<std::string> specs;
+        size_t                   added = 0;
+
+        if(numRows_)
+        {
+            throw std::logic_error("Indicators must be added before deriving");
+        }
+        boost::split(specs, spec, boost::is_any_of("; \t"), boost::token_compress_on);
+
+        for(auto& one : specs)
+        {
+            std::vector<std::string> fields;
+            std::vector<std::string> periods;
+            Kind                     kind = SMA;
+
+            if(one.empty())
+            {
+                continue;
+            }
+            boost::split(fields, one, boost::is_any_of(":"));
+            if(3 == fields.size())
+            {
+                auto k = std::find(std::begin(KindNames), std::end(KindNames), boost::to_lower_copy(fields[0]));
+
+                if(k == std::end(KindNames))
+                {
+                    throw std::invalid_argument("Unknown indicator: " + one);
+                }
+                kind = static_cast<Kind>(k - std::begin(KindNames));
+                fields.erase(fields.begin());
+            }
+            if(2 != fields.size())
+            {
+                throw std::invalid_argument("Bad indicator spec: " + one);
+            }
+
+            auto   attr = std::find(baseNames.begin(), baseNames.end(), fields[0]);
+            size_t base = attr - baseNames.begin();
+
+            if(attr == baseNames.end())
+            {
+                throw std::invalid_argument("Unknown attribute for indicator: " + one);
+            }
+
+            boost::split(periods, fields[1], boost::is_any_of(","));
+            for(auto& per : periods)
+            {
+                size_t period = boost::lexical_cast<size_t>(per);
+
+                if(!period)
+                {
+                    throw std::invalid_argument("Bad indicator period: " + one);
+                }
+                derived_.push_back(Derived { kind, base, period,
+                                             fields[0] + "." + KindNames[kind] + per });
+                ++added;
+            }
+
+            // Note which bases need running sums
+            if(base >= needSums_.size())
+            {
+                needSums_.resize(base + 1, false);
+                needSqs_.resize(base + 1, false);
+                sums_.resize(base + 1);
+                sumSqs_.resize(base + 1);
+            }
+            needSums_[base] = needSums_[base] || (SMA == kind) || (STD == kind);
+            needSqs_[base]  = needSqs_[base]  || (STD == kind);
+        }
+        return added;
+    }
+
+
+    /**
+     * Returns the number of derived attribute columns
+     *///--------------------------------------------------------------------
+    size_t getNumDerived() const
+    {
+        return derived_.size();
+    }
+
+
+    /**
+     * Returns the number of rows derived so far
+     *///--------------------------------------------------------------------
+    size_t getNumRows() const
+    {
+        return numRows_;
+    }
+
+
+    /**
+     * Returns a derived attribute's name, e.g., "close.sma50"
+     *///--------------------------------------------------------------------
+    const std::string& getName(size_t ndx) const
+    {
+        return derived_.at(ndx).name_;
+    }
+
+
+    /**
+     * Returns a derived attribute column, oldest day first
+     *///--------------------------------------------------------------------
+    const std::vector<Real>& column(size_t ndx) const
+    {
+        return derived_.at(ndx).col_;
+    }
+
+
+    /**
+     * Derives all indicators from scratch
+     *
+     * @param base      Pointers to the base attribute columns
+     * @param numRows   Number of days in each base column
+     *///--------------------------------------------------------------------
+    void derive(const std::vector<const Real*>& base, size_t numRows)
+    {
+        numRows_ = 0;
+        for(auto& sums : sums_)         sums.clear();
+        for(auto& sqs  : sumSqs_)       sqs.clear();
+        for(auto& der  : derived_)
+        {
+            der.col_.clear();
+            der.seen_    = 0;
+            der.avgGain_ = 0.0;
+            der.avgLoss_ = 0.0;
+        }
+        extend(base, numRows);
+    }
+
+
+    /**
+     * Derives the indicators for the days added to the base columns since
+     * the last call.  The base columns may also have dropped their oldest
+     * days (as PriceCache does when it reaches capacity), in which case the
+     * derived columns drop them too.
+     *
+     * @param base      Pointers to the base attribute columns
+     * @param numRows   Number of days now in each base column
+     * @param dropped   Number of old days dropped from the front
+     *///--------------------------------------------------------------------
+    void extend(const std::vector<const Real*>& base, size_t numRows, size_t dropped = 0)
+    {
+        if((dropped > numRows_) || (numRows_ - dropped > numRows) || (base.size() < needSums_.size()))
+        {
+            throw std::invalid_argument("Price data does not follow derived attributes");
+        }
+
+        const size_t from = numRows_ - dropped;
+
+        // Bring the running sums up to date first; the windowed indicators read them
+        for(size_t b = 0; b < needSums_.size(); ++b)
+        {
+            if(needSums_[b])    extendSums(sums_[b],   base[b], from, numRows, dropped, false);
+            if(needSqs_[b])     extendSums(sumSqs_[b], base[b], from, numRows, dropped, true);
+        }
+
+        for(auto& der : derived_)
+        {
+            const Real *x = base[der.base_];
+
+            if(dropped)
+            {
+                der.col_.erase(der.col_.begin(), der.col_.begin() + dropped);
+            }
+            der.col_.resize(numRows);
+
+            switch(der.kind_)
+            {
+                case SMA: deriveSMA(der, sums_[der.base_], from, numRows);                      break;
+                case EMA: deriveEMA(der, x, from, numRows);                                     break;
+                case STD: deriveSTD(der, sums_[der.base_], sumSqs_[der.base_], from, numRows);  break;
+                case RSI: deriveRSI(der, x, from, numRows);                                     break;
+                case RET: deriveRET(der, x, from, numRows);                                     break;
+            }
+            der.seen_ += numRows - from;
+        }
+        numRows_ = numRows;
+    }
+
+
+private:
+    /**
+     * One derived attribute and its carried state
+     */
+    struct Derived
+    {
+        Kind                kind_;          ///< Indicator
+        size_t              base_;          ///< Base attribute column
+        size_t              period_;        ///< Window/lag in days
+        std::string         name_;          ///< Attribute name
+        std::vector<Real>   col_;           ///< Derived values
+        size_t              seen_;          ///< Days processed, including dropped ones
+        double              avgGain_;       ///< RSI: smoothed gain
+        double              avgLoss_;       ///< RSI: smoothed loss
+
+        Derived(Kind kind, size_t base, size_t period, const std::string& name)
+        : kind_(kind), base_(base), period_(period), name_(name),
+          seen_(0), avgGain_(0.0), avgLoss_(0.0)
+        { }
+    };
+
+    std::vector<Derived>                derived_;       ///< Indicators, in spec order
+    std::vector<bool>                   needSums_;      ///< Per base: keep sum(x)?
+    std::vector<bool>                   needSqs_;       ///< Per base: keep sum(x^2)?
+    std::vector<std::vector<double>>    sums_;          ///< Per base: prefix sum(x), numRows_+1
+    std::vector<std::vector<double>>    sumSqs_;        ///< Per base: prefix sum(x^2), numRows_+1
+    size_t                              numRows_;       ///< Rows derived so far
+
+
+    /*
+     * Prefix sums: P[i+1] = P[i] + x[i], so any window sum is P[b] - P[a].
+     * Dropping old days just drops the front of P; the differences hold.
+     */
+    static void extendSums(std::vector<double>& P, const Real *x,
+                           size_t from, size_t to, size_t dropped, bool squares)
+    {
+        if(P.empty())
+        {
+            P.push_back(0.0);
+        }
+        if(dropped)
+        {
+            P.erase(P.begin(), P.begin() + dropped);
+        }
+        P.resize(to + 1);
+        for(size_t i = from; i < to; ++i)
+        {
+            P[i + 1] = P[i] + (squares ? (double) x[i] * x[i] : (double) x[i]);
+        }
+    }
+
+
+    static size_t windowStart(size_t i, size_t period)
+    {
+        return (i + 1 >= period) ? (i + 1 - period) : 0;
+    }
+
+
+    static void deriveSMA(Derived& der, const std::vector<double>& P, size_t from, size_t to)
+    {
+        const size_t n    = der.period_;
+        size_t       full = std::max(from, std::min(to, n - 1));
+        Real        *col  = der.col_.data();
+
+        for(size_t i = from; i < full; ++i)                         // Partial windows
+        {
+            size_t a = windowStart(i, n);
+            col[i]   = (P[i + 1] - P[a]) / (i + 1 - a);
+        }
+        for(size_t i = full; i < to; ++i)                           // Steady state
+        {
+            col[i] = (P[i + 1] - P[i + 1 - n]) / n;
+        }
+    }
+
+
+    static void deriveSTD(Derived& der, const std::vector<double>& P, const std::vector<double>& Q,
+                          size_t from, size_t to)
+    {
+        const size_t n   = der.period_;
+        Real        *col = der.col_.data();
+
+        for(size_t i = from; i < to; ++i)
+        {
+            size_t a    = windowStart(i, n);
+            double cnt  = i + 1 - a;
+            double mean = (P[i + 1] - P[a]) / cnt;
+            double var  = (Q[i + 1] - Q[a]) / cnt - (mean * mean);
+
+            col[i] = std::sqrt(std::max(var, 0.0));                 // Rounding may go a hair < 0
+        }
+    }
+
+
+    static void deriveEMA(Derived& der, const Real *x, size_t from, size_t to)
+    {
+        const double alpha = 2.0 / (der.period_ + 1);
+        Real        *col   = der.col_.data();
+
+        for(size_t i = from; i < to; ++i)
+        {
+            col[i] = i ? col[i - 1] + alpha * (x[i] - col[i - 1])
+                       : x[i];
+        }
+    }
+
+
+    static void deriveRSI(Derived& der, const Real *x, size_t from, size_t to)
+    {
+        const double n   = der.period_;
+        Real        *col = der.col_.data();
+
+        for(size_t i = from; i < to; ++i)
+        {
+            size_t day = der.seen_ + (i - from);                    // Absolute day, for the warm-up
+
+            if(day && i)
+            {
+                double delta = x[i] - x[i - 1];
+                double gain  = std::max(delta, 0.0);
+                double loss  = std::max(-delta, 0.0);
+                double k     = std::min<double>(day, n);            // Simple average until we have n
+
+                der.avgGain_ = (der.avgGain_ * (k - 1) + gain) / k;
+                der.avgLoss_ = (der.avgLoss_ * (k - 1) + loss) / k;
+            }
+
+            col[i] = (der.avgLoss_ > 0.0) ? 100.0 - 100.0 / (1.0 + der.avgGain_ / der.avgLoss_)
+                                          : ((der.avgGain_ > 0.0) ? 100.0 : 50.0);
+        }
+    }
+
+
+    static void deriveRET(Derived& der, const Real *x, size_t from, size_t to)
+    {
+        const size_t lag = der.period_;
+        Real        *col = der.col_.data();
+
+        for(size_t i = from; i < to; ++i)
+        {
+            const Real prev = x[(i >= lag) ? (i - lag) : 0];
+
+            col[i] = (prev != 0.0) ? (x[i] / prev) - 1.0 : 0.0;
+        }
+    }
+};
+
+
+} } // ns{ oi::market }
+
+#endif	/* ATTRDERIVER_HPP */
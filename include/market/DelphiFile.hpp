@@ -0,0 +1,285 @@
+/*\***********************************************************************\*//**
+ * MODULE: DelphiFile.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef DELPHIFILE_HPP
+#define	DELPHIFILE_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "ostrich.hpp"
+
+namespace oi { namespace market {
+
+
+// --------------------------------------------------------------------------
+// DelphiFile:
+// --------------------------------------------------------------------------
+/**
+ * File-backed stand-in for the Delphi database, for offline runs and for
+ * repeatable end-to-end performance runs (with --seeds48) on a machine with
+ * no PostgreSQL.  It offers the same calls that Sibyl makes on Delphi, and
+ * is selected with --delphi-dir.  The directory holds:
+ *
+ *  - securities.csv            symbol,YYYY-MM-DD (last update), one per line
+ *  - prices/SYMBOL.csv         header line of attribute names, then one line
+ *                              of values per day, oldest first
+ *  - models.tsv                models written by addModel(), also the source
+ *                              for pullBestTravellers()
+ *
+ * Lines starting with '#' are comments.  Nothing is cached between calls
+ * except the security list, so files may be swapped between runs.
+ */
+// --------------------------------------------------------------------------
+class DelphiFile
+{
+public:
+    /**
+     * A security, as listed in securities.csv
+     */
+    struct Security
+    {
+        std::string                 symbol_;        ///< Stock symbol
+        boost::gregorian::date      lastUpdate_;    ///< Latest trading day on file
+    };
+
+    using SecurityPack = std::vector<Security>;
+
+
+    /**
+     * Opens the stand-in "database"
+     *
+     * @param dir   Directory holding the Delphi files (plays the part of
+     *              Delphi's DB host)
+     * @param user  Ignored, for compatibility with Delphi
+     *///--------------------------------------------------------------------
+    DelphiFile(const std::string& dir, const std::string& user = "")
+    : dir_(dir)
+    { }
+
+
+    void activate()     { }         ///< Nothing to connect to
+    void deactivate()   { }         ///< Nothing to disconnect from
+
+
+    /**
+     * Returns the securities to run
+     *
+     * @param activeOnly    Ignored (all listed securities are active)
+     * @param symbols       CSV list of symbols, or "*" for all of them
+     *
+     * @return              The (filtered) security list
+     *///--------------------------------------------------------------------
+    const SecurityPack& getSecurities(bool activeOnly, const std::string& symbols)
+    {
+        std::vector<std::string> wanted;
+        std::vector<std::string> fields;
+
+        boost::split(wanted, symbols, boost::is_any_of(", "), boost::token_compress_on);
+        secPack_.clear();
+
+        for(auto& line : readLines(dir_ + "/securities.csv"))
+        {
+            boost::split(fields, line, boost::is_any_of(","));
+            if(fields.size() >= 2)
+            {
+                Security sec = { boost::trim_copy(fields[0]),
+                                 boost::gregorian::from_simple_string(boost::trim_copy(fields[1])) };
+
+                if((symbols == "*") || (std::find(wanted.begin(), wanted.end(), sec.symbol_) != wanted.end()))
+                {
+                    secPack_.push_back(sec);
+                }
+            }
+        }
+        return secPack_;
+    }
+
+
+    /**
+     * Reads the newest days of price history for a security
+     *
+     * @param symbol    Stock symbol
+     * @param numDays   Maximum days (records) to pull
+     * @param names     Output: attribute names, one per column
+     * @param cols      Output: cols[attr][day], oldest first
+     *
+     * @return          The number of days pulled
+     *///--------------------------------------------------------------------
+    int pullPrices(const std::string&               symbol,
+                   int                              numDays,
+                   std::vector<std::string>&        names,
+                   std::vector<std::vector<Real>>&  cols)
+    {
+        std::vector<std::string> lines = readLines(dir_ + "/prices/" + symbol + ".csv");
+        std::vector<std::string> fields;
+
+        names.clear();
+        cols.clear();
+        if(lines.empty())
+        {
+            return 0;
+        }
+
+        boost::split(names, lines[0], boost::is_any_of(","));
+        for(auto& name : names)
+        {
+            boost::trim(name);
+        }
+        cols.resize(names.size());
+
+        size_t first = (lines.size() - 1 > (size_t) numDays) ? (lines.size() - numDays) : 1;
+
+        for(size_t i = first; i < lines.size(); ++i)
+        {
+            boost::split(fields, lines[i], boost::is_any_of(","));
+            if(fields.size() != names.size())
+            {
+                throw std::runtime_error("Bad price record for " + symbol + ": " + lines[i]);
+            }
+            for(size_t c = 0; c < fields.size(); ++c)
+            {
+                cols[c].push_back(boost::lexical_cast<Real>(boost::trim_copy(fields[c])));
+            }
+        }
+        return cols[0].size();
+    }
+
+
+    /**
+     * Pulls the best models from previous runs for use as travellers
+     *
+     * @param symbol        Model works for this Stock symbol
+     * @param fnName        Functional (short) name for the target attribute
+     * @param days          Number of days ahead the model prophesies
+     * @param modelCode     Delphi model version
+     * @param useGLD        Whether the model used GLD as an extra attribute
+     * @param daysToPull    Ignored, for compatibility with Delphi
+     * @param count         Maximum number of models to pull
+     * @param travellers    Output vector for the models, best first
+     * @param out           Output stream for logging
+     *
+     * @return              The number of travellers pulled
+     *///--------------------------------------------------------------------
+    template<class TravellerT>
+    int pullBestTravellers(const std::string&       symbol,
+                           const std::string&       fnName,
+                           size_t                   days,
+                           const std::string&       modelCode,
+                           bool                     useGLD,
+                           int                      daysToPull,
+                           size_t                   count,
+                           std::vector<TravellerT>& travellers,
+                           std::ostream&            out)
+    {
+        std::vector<std::pair<Real, std::string>> models;
+        std::vector<std::string>                  fields;
+
+        for(auto& line : readLines(dir_ + "/models.tsv"))
+        {
+            boost::split(fields, line, boost::is_any_of("\t"));
+            if((fields.size() == NUM_MODEL_FIELDS)
+                && (fields[0] == symbol)
+                && (fields[1] == fnName)
+                && (fields[2] == std::to_string(days))
+                && (fields[3] == modelCode)
+                && (fields[10] == (useGLD ? "1" : "0")))
+            {
+                models.emplace_back(boost::lexical_cast<Real>(fields[5]), fields[7]);
+            }
+        }
+
+        // Best first; stable so equally fit models come out in file order
+        std::stable_sort(models.begin(), models.end(),
+                         [](const std::pair<Real, std::string>& a,
+                            const std::pair<Real, std::string>& b) { return a.first > b.first; });
+
+        travellers.clear();
+        for(size_t i = 0; (i < models.size()) && (i < count); ++i)
+        {
+            travellers.emplace_back(models[i].second, models[i].first);
+        }
+        return travellers.size();
+    }
+
+
+    /**
+     * Appends a model (and its prophecy) to models.tsv
+     *
+     * @return  true if the model was written
+     *///--------------------------------------------------------------------
+    template<class Prophecy, class Solution, class CPUTime, class WallSecs>
+    bool addModel(const std::string&    symbol,
+                  const std::string&    fnName,
+                  size_t                days,
+                  const std::string&    modelCode,
+                  const std::string&    tradeDate,
+                  Real                  fitness,
+                  const Prophecy&       prophecy,
+                  const Solution&       solution,
+                  const CPUTime&        cpuTime,
+                  const WallSecs&       wallSecs,
+                  bool                  useGLD,
+                  std::ostream&         out)
+    {
+        std::ostringstream record;
+        std::ofstream      file(dir_ + "/models.tsv", std::ios::app);
+
+        record.precision(17);
+        record << symbol    << '\t' << fnName   << '\t' << days     << '\t'
+               << modelCode << '\t' << tradeDate << '\t' << fitness << '\t'
+               << prophecy  << '\t' << solution << '\t' << cpuTime  << '\t'
+               << wallSecs  << '\t' << (useGLD ? 1 : 0) << '\n';
+
+        // One write per record, so concurrent loner workers don't interleave
+        file << record.str() << std::flush;
+        if(!file.good())
+        {
+            out << "DelphiFile: cannot save model for " << symbol << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+
+private:
+    static constexpr size_t NUM_MODEL_FIELDS = 11;      ///< Columns in models.tsv
+
+    std::string     dir_;           ///< Where the Delphi files live
+    SecurityPack    secPack_;       ///< Today's securities
+
+    static std::vector<std::string> readLines(const std::string& path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream            in(path.c_str());
+        std::string              line;
+
+        while(std::getline(in, line))
+        {
+            if(!line.empty() && ('#' != line[0]))
+            {
+                lines.push_back(line);
+            }
+        }
+        return lines;
+    }
+};
+
+
+} } // ns{ oi::market }
+
+#endif	/* DELPHIFILE_HPP */
@@ -0,0 +1,322 @@
+/*\***********************************************************************\*//**
+ * MODULE: DelphiWriter.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef DELPHIWRITER_HPP
+#define	DELPHIWRITER_HPP
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include <boost/thread.hpp>
+
+#include <pqxx/except>
+
+namespace oi { namespace market {
+
+
+// --------------------------------------------------------------------------
+// DelphiWriter:
+// --------------------------------------------------------------------------
+/**
+ * Background writer for Delphi results (models, prophecies).  The compute
+ * loop posts its writes and carries on; a writer thread with its OWN Delphi
+ * connection works through them in order, one write (and transaction) at a
+ * time: the backends take one model per call.
+ *
+ *  - The queue is bounded.  post() blocks when it is full, so a DB host that
+ *    has gone away can't make us eat all our memory.
+ *  - Broken connections and serialization failures are retried with
+ *    backoff on a fresh connection.  Anything else fails the write at once:
+ *    constraint and data errors would only fail again, and a commit whose
+ *    outcome is unknown (in doubt) may already have gone through, so
+ *    retrying it could insert a second model row.
+ *  - flush() waits for everything posted so far, and can release the
+ *    connection for the night, just like Delphi::deactivate().
+ *
+ * The writer thread's log output is held and relayed to the caller's stream
+ * from post() and flush(), so the Logger is only ever written by the thread
+ * that owns it.
+ *
+ * The thread starts with the first post(), so a process that never writes
+ * (a --discrete run) never starts it.
+ *
+ * @tparam DB   Delphi backend; constructed from (host, user)
+ */
+// --------------------------------------------------------------------------
+template<class DB>
+class DelphiWriter
+{
+public:
+    using Task = std::function<void(DB& db, std::ostream& log)>;     ///< One Delphi write
+
+
+    /**
+     * Creates a writer.  The thread starts, and the connection is made, when
+     * the first write comes in.
+     *
+     * @param host          Database server running Delphi
+     * @param user          Database user with rights to Delphi
+     * @param maxQueue      Writes we'll hold before post() blocks
+     * @param maxRetries    Retries before we give up on a write
+     *///--------------------------------------------------------------------
+    DelphiWriter(const std::string& host,
+                 const std::string& user,
+                 size_t             maxQueue   = 64,
+                 int                maxRetries = 5)
+    : host_         (host),
+      user_         (user),
+      maxQueue_     (maxQueue),
+      maxRetries_   (maxRetries),
+      inFlight_     (0),
+      numFailed_    (0),
+      isStopping_   (false),
+      releaseConn_  (false)
+    { }
+
+
+    /**
+     * Finishes all pending writes and stops the writer thread
+     *///--------------------------------------------------------------------
+    ~DelphiWriter()
+    {
+        if(!thread_.joinable())
+        {
+            return;                     // Never wrote anything
+        }
+        {
+            boost::lock_guard<boost::mutex> guard(lock_);
+            isStopping_ = true;
+        }
+        hasWork_.notify_all();
+        thread_.join();
+    }
+
+
+    DelphiWriter(const DelphiWriter& that) = delete;                ///< DISABLED!
+    DelphiWriter & operator=(const DelphiWriter& rhs) = delete;     ///< DISABLED!
+
+
+    /**
+     * Queues a write.  Blocks if the queue is full.
+     *
+     * @param task  The write, which must capture everything it needs by value
+     * @param out   Output stream for logging (gets any held writer output)
+     *///--------------------------------------------------------------------
+    void post(Task task, std::ostream& out)
+    {
+        {
+            boost::unique_lock<boost::mutex> guard(lock_);
+
+            while(queue_.size() >= maxQueue_)
+            {
+                hasSpace_.wait(guard);
+            }
+            queue_.push_back(std::move(task));
+            ++inFlight_;
+
+            if(!thread_.joinable())
+            {
+                thread_ = boost::thread(&DelphiWriter::work, this);
+            }
+        }
+        hasWork_.notify_one();
+        relayLog(out);
+    }
+
+
+    /**
+     * Waits until every write posted so far is done (or has failed).
+     *
+     * @param out       Output stream for logging
+     * @param release   Drop the writer's DB connection once it's idle
+     *
+     * @return          Number of writes that have failed since the writer
+     *                  was created
+     *///--------------------------------------------------------------------
+    size_t flush(std::ostream& out, bool release = false)
+    {
+        {
+            boost::unique_lock<boost::mutex> guard(lock_);
+
+            releaseConn_ = release;
+            while(inFlight_)
+            {
+                isIdle_.wait(guard);
+            }
+        }
+        hasWork_.notify_one();          // Let the thread see releaseConn_
+        relayLog(out);
+
+        boost::lock_guard<boost::mutex> guard(lock_);
+        return numFailed_;
+    }
+
+
+private:
+    const std::string   host_;          ///< Delphi host
+    const std::string   user_;          ///< Delphi user
+    const size_t        maxQueue_;      ///< Bound on queued writes
+    const int           maxRetries_;    ///< Attempts beyond the first
+
+    boost::mutex                lock_;          ///< Protects everything below
+    boost::condition_variable   hasWork_;       ///< Queue not empty (or stopping)
+    boost::condition_variable   hasSpace_;      ///< Queue not full
+    boost::condition_variable   isIdle_;        ///< Nothing in flight
+    std::deque<Task>            queue_;         ///< Pending writes
+    size_t                      inFlight_;      ///< Queued plus being written
+    size_t                      numFailed_;     ///< Writes we gave up on
+    bool                        isStopping_;    ///< Destructor called
+    bool                        releaseConn_;   ///< Drop connection when idle
+    std::string                 heldLog_;       ///< Writer output for the caller's log
+
+    boost::thread               thread_;        ///< Writer (started by the first post)
+
+
+    /**
+     * Writer thread: takes writes off the queue and makes them in Delphi
+     *///--------------------------------------------------------------------
+    void work()
+    {
+        std::unique_ptr<DB> db;
+
+        while(true)
+        {
+            Task task;
+            {
+                boost::unique_lock<boost::mutex> guard(lock_);
+
+                while(queue_.empty() && !isStopping_)
+                {
+                    if(releaseConn_ && db)
+                    {
+                        db.reset();
+                        releaseConn_ = false;
+                    }
+                    hasWork_.wait(guard);
+                }
+                if(queue_.empty())
+                {
+                    break;                  // Stopping, and nothing left to do
+                }
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            hasSpace_.notify_one();
+
+            std::ostringstream log;
+
+            for(int attempt = 0; ; ++attempt) try
+            {
+                if(!db)
+                {
+                    db.reset(new DB(host_, user_));
+                }
+                task(*db, log);
+                break;
+            }
+            catch(pqxx::in_doubt_error& e)
+            {
+                // The commit may have happened: never write it twice
+                db.reset();
+                fail(log, "commit in doubt", e);
+                break;
+            }
+            catch(pqxx::broken_connection& e)
+            {
+                if(!retryOrFail(db, log, attempt, e)) break;
+            }
+            catch(pqxx::serialization_failure& e)
+            {
+                if(!retryOrFail(db, log, attempt, e)) break;
+            }
+            catch(std::exception& e)
+            {
+                // Constraint, data, etc.: trying again won't help
+                db.reset();
+                fail(log, "write failed", e);
+                break;
+            }
+
+            {
+                boost::lock_guard<boost::mutex> guard(lock_);
+                heldLog_ += log.str();
+                --inFlight_;
+            }
+            isIdle_.notify_all();
+        }
+    }
+
+
+    /**
+     * Handles a transient failure: backs off for another attempt on a fresh
+     * connection, or gives up once the retries run out.
+     *
+     * @param db        The writer's connection (dropped)
+     * @param log       Writer output for this task
+     * @param attempt   Attempts so far, less one
+     * @param e         What went wrong
+     *
+     * @return          true to try again; false if we gave up
+     *///--------------------------------------------------------------------
+    bool retryOrFail(std::unique_ptr<DB>& db, std::ostream& log, int attempt, const std::exception& e)
+    {
+        using namespace boost::posix_time;
+
+        db.reset();
+        if(attempt >= maxRetries_)
+        {
+            fail(log, "out of retries", e);
+            return false;
+        }
+        log << "DelphiWriter: write failed (attempt " << (attempt + 1) << "): " << e.what() << '\n';
+        boost::this_thread::sleep(milliseconds(250 << attempt));
+        return true;
+    }
+
+
+    /**
+     * Gives up on a write
+     *
+     * @param log       Writer output for this task
+     * @param why       Why we're giving up
+     * @param e         What went wrong
+     *///--------------------------------------------------------------------
+    void fail(std::ostream& log, const char *why, const std::exception& e)
+    {
+        log << "DelphiWriter: giving up on write (" << why << "): " << e.what() << '\n';
+
+        boost::lock_guard<boost::mutex> guard(lock_);
+        ++numFailed_;
+    }
+
+
+    /**
+     * Sends any held writer output to the caller's log stream
+     *///--------------------------------------------------------------------
+    void relayLog(std::ostream& out)
+    {
+        std::string text;
+        {
+            boost::lock_guard<boost::mutex> guard(lock_);
+            text.swap(heldLog_);
+        }
+        if(!text.empty())
+        {
+            out << text << std::flush;
+        }
+    }
+};
+
+
+} } // ns{ oi::market }
+
+#endif	/* DELPHIWRITER_HPP */
@@ -0,0 +1,322 @@
+/*\***********************************************************************\*//**
+ * MODULE: PriceCache.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef PRICECACHE_HPP
+#define	PRICECACHE_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "util/ColumnBlock.hpp"
+
+namespace oi { namespace market {
+
+
+// --------------------------------------------------------------------------
+// PriceCache:
+// --------------------------------------------------------------------------
+/**
+ * On-disk, memory-mapped price history for one security: a single file per
+ * symbol holding a util::ColumnBlock (column directory plus one column per
+ * attribute).  The block's stamp is the Delphi last update (YYYYMMDD) of the
+ * newest cached day, so the daily loop only needs to pull the days since
+ * then and append them.  Once the file is mapped, the price data is a page
+ * cache hit and PriceDataPack can read the columns without copying them.
+ *
+ * The cache keeps the newest getCapacity() days; appending past that drops
+ * the oldest days.  An flock on the file serializes updates across ranks
+ * and loner workers: we hold it exclusively from open() through our
+ * updates, then shared (via publish()) for as long as we read the mapping.
+ *
+ * An update zeroes the stamp before it touches the columns and only sets
+ * it again once they are complete, so a crash partway through leaves a
+ * file that no stamp matches, and the next run rebuilds it.
+ *
+ *  open(symbol)                 ->  stamp == lastUpdate?  use it
+ *                                   stamp <  lastUpdate?  pull days > stamp, append()
+ *                                   stamp == 0 (new)?     pull everything, append()
+ *  publish()                    ->  readers may proceed
+ *
+ * Nothing opens a cache yet.  PriceDataPack still pulls the full history
+ * from Delphi on every load, and until it maps a PriceCache in its place
+ * (and shares the mapping), no code path reaches this class.
+ */
+// --------------------------------------------------------------------------
+class PriceCache
+{
+public:
+    /**
+     * Creates a cache rooted in the specified directory
+     *
+     * @param dir   Directory for the cache files
+     *///--------------------------------------------------------------------
+    explicit PriceCache(const std::string& dir)
+    : dir_  (dir),
+      fd_   (-1),
+      mem_  (MAP_FAILED),
+      size_ (0)
+    { }
+
+
+    /**
+     * Unmaps and unlocks the current file
+     *///--------------------------------------------------------------------
+    ~PriceCache()
+    {
+        release();
+    }
+
+
+    PriceCache(const PriceCache& that) = delete;                ///< DISABLED!
+    PriceCache & operator=(const PriceCache& rhs) = delete;     ///< DISABLED!
+
+
+    /**
+     * Maps the cache file for a security, creating (or recreating) it if it
+     * is missing or does not match the requested layout.  The file is left
+     * exclusively locked for the caller's updates; call publish() when done.
+     *
+     * @param symbol    Stock symbol
+     * @param names     Attribute names, one column each
+     * @param capacity  Number of days to keep (CFG_DAYS_TO_PULL)
+     *
+     * @return          The cached block, with a zero stamp if it is new
+     *///--------------------------------------------------------------------
+    util::ColumnBlock& open(const std::string&              symbol,
+                            const std::vector<std::string>& names,
+                            size_t                          capacity)
+    {
+        struct stat info;
+        std::string path = dir_ + "/" + symbol + ".cols";
+
+        release();
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0664);
+        if(fd_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "Cannot open price cache " + path);
+        }
+        if((flock(fd_, LOCK_EX) < 0) || (fstat(fd_, &info) < 0))
+        {
+            throw std::system_error(errno, std::generic_category(), "Cannot lock price cache " + path);
+        }
+
+        // Can we use what's there?
+        if(info.st_size > 0)
+        {
+            mapFile(info.st_size, path);
+            block_ = util::ColumnBlock(mem_);
+            if(!isLayout(names, capacity))
+            {
+                unmapFile();
+            }
+        }
+
+        // Start over if we must
+        if(MAP_FAILED == mem_)
+        {
+            size_t size = util::ColumnBlock::sizeFor(names.size(), capacity);
+
+            if(ftruncate(fd_, 0) < 0 || ftruncate(fd_, size) < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "Cannot size price cache " + path);
+            }
+            mapFile(size, path);
+            block_ = util::ColumnBlock::format(mem_, names, capacity, 0, symbol);
+            block_.setReady();
+        }
+        return block_;
+    }
+
+
+    /**
+     * Returns true if the cache already holds the specified last update
+     *
+     * @param stamp     Delphi last update as YYYYMMDD
+     *///--------------------------------------------------------------------
+    bool isCurrent(int64_t stamp) const
+    {
+        return (MAP_FAILED != mem_) && (stamp == block_.getStamp());
+    }
+
+
+    /**
+     * Appends new days to the cache, dropping the oldest days if we go over
+     * capacity.  If a column has more new days than the capacity, only the
+     * newest are kept.
+     *
+     * @param days      New data: days[col][n], oldest first.  All columns
+     *                  must have the same number of days.
+     * @param stamp     Delphi last update (YYYYMMDD) of the newest day
+     *
+     * @note    The stamp is zeroed (and synced) before the columns change,
+     *          then set (and synced) after, so a half-shifted file never
+     *          passes isCurrent().
+     *///--------------------------------------------------------------------
+    void append(const std::vector<std::vector<Real>>& days, int64_t stamp)
+    {
+        const size_t numCols  = block_.getNumCols();
+        const size_t capacity = block_.getCapacity();
+        size_t       numNew   = days.empty() ? 0 : days[0].size();
+        size_t       skip     = 0;
+        size_t       numRows  = block_.getNumRows();
+
+        if(days.size() != numCols)
+        {
+            throw std::invalid_argument("Price cache column mismatch");
+        }
+        for(auto& newDays : days)
+        {
+            if(newDays.size() != numNew)
+            {
+                throw std::invalid_argument("Price cache row mismatch");
+            }
+        }
+        if(numNew > capacity)
+        {
+            skip   = numNew - capacity;
+            numNew = capacity;
+        }
+
+        // Roll the oldest days off the front if we need the room
+        size_t drop = (numRows + numNew > capacity) ? (numRows + numNew - capacity) : 0;
+
+        // Invalidate the file until we're done with it
+        block_.setStamp(0);
+        syncHeader();
+
+        for(size_t c = 0; c < numCols; ++c)
+        {
+            Real *col = block_.column(c);
+
+            if(drop)
+            {
+                memmove(col, col + drop, (numRows - drop) * sizeof(Real));
+            }
+            memcpy(col + numRows - drop, days[c].data() + skip, numNew * sizeof(Real));
+        }
+        block_.setNumRows(numRows - drop + numNew);
+        msync(mem_, size_, MS_SYNC);
+
+        block_.setStamp(stamp);
+        syncHeader();
+    }
+
+
+    /**
+     * Empties the cache (e.g., when Delphi has restated history) so that the
+     * next append() rebuilds it.
+     *///--------------------------------------------------------------------
+    void clear()
+    {
+        block_.setStamp(0);
+        block_.setNumRows(0);
+        syncHeader();
+    }
+
+
+    /**
+     * Ends our updates: trades our exclusive lock for a shared one so other
+     * readers may map the file, while nobody may update it under us.
+     *
+     * @note    This is NOT an atomic downgrade.  On Linux, flock(LOCK_SH)
+     *          drops the exclusive lock before taking the shared one, so
+     *          another process may get in and update the file between the
+     *          two.  Re-read the row count and stamp from the returned block
+     *          rather than relying on what they were before publish().
+     *
+     * @return  The read-only block
+     *///--------------------------------------------------------------------
+    const util::ColumnBlock& publish()
+    {
+        flock(fd_, LOCK_SH);
+        return block_;
+    }
+
+
+    /**
+     * Unmaps the current file and drops our lock
+     *///--------------------------------------------------------------------
+    void release()
+    {
+        unmapFile();
+        if(fd_ >= 0)
+        {
+            close(fd_);             // Drops the flock
+            fd_ = -1;
+        }
+    }
+
+
+private:
+    std::string         dir_;           ///< Where the cache files live
+    int                 fd_;            ///< Current cache file
+    void               *mem_;           ///< Current mapping
+    size_t              size_;          ///< Bytes mapped
+    util::ColumnBlock   block_;         ///< View on the mapping
+
+    void mapFile(size_t size, const std::string& path)
+    {
+        mem_ = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if(MAP_FAILED == mem_)
+        {
+            throw std::system_error(errno, std::generic_category(), "Cannot map price cache " + path);
+        }
+        size_ = size;
+    }
+
+    void syncHeader()
+    {
+        msync(mem_, std::min<size_t>(size_, sysconf(_SC_PAGESIZE)), MS_SYNC);
+    }
+
+    void unmapFile()
+    {
+        if(MAP_FAILED != mem_)
+        {
+            munmap(mem_, size_);
+            mem_ = MAP_FAILED;
+        }
+        block_ = util::ColumnBlock();
+        size_  = 0;
+    }
+
+    bool isLayout(const std::vector<std::string>& names, size_t capacity) const
+    {
+        if(!block_.isValid(size_)
+            || (block_.getCapacity() != capacity)
+            || (block_.getNumCols()  != names.size())
+            || (block_.getByteSize() != size_))
+        {
+            return false;
+        }
+        for(size_t c = 0; c < names.size(); ++c)
+        {
+            if(block_.getName(c) != names[c])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+
+} } // ns{ oi::market }
+
+#endif	/* PRICECACHE_HPP */
@@ -0,0 +1,529 @@
+/*\***********************************************************************\*//**
+ * MODULE: AsyncLog.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef ASYNCLOG_HPP
+#define	ASYNCLOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+/**
+ * Compile-time log threshold, using the syslog level numbers (configure
+ * --with-log-level).  ALOG_xxx calls above it compile to nothing, and their
+ * arguments are never evaluated.
+ */
+#ifndef SIBYL_LOG_LEVEL
+#  define SIBYL_LOG_LEVEL   7
+#endif
+
+#define OI_ALOG(alog, level, tag, ...)                                          \
+    do { if((level) <= SIBYL_LOG_LEVEL) (alog).post(tag, __VA_ARGS__); } while(0)
+
+#define ALOG_ERR(alog, ...)     OI_ALOG(alog, 3, LOG_ERR,     __VA_ARGS__)
+#define ALOG_WARN(alog, ...)    OI_ALOG(alog, 4, LOG_WARN,    __VA_ARGS__)
+#define ALOG_NOTICE(alog, ...)  OI_ALOG(alog, 5, LOG_NOTICE,  __VA_ARGS__)
+#define ALOG_INFO(alog, ...)    OI_ALOG(alog, 6, LOG_INFO,    __VA_ARGS__)
+#define ALOG_DEBUG(alog, ...)   OI_ALOG(alog, 7, LOG_DEBUG,   __VA_ARGS__)
+
+namespace oi { namespace util {
+
+
+// --------------------------------------------------------------------------
+// AsyncLog:
+// --------------------------------------------------------------------------
+/**
+ * Asynchronous front end for a log stream (normally a util::Logger).  Each
+ * thread that logs gets its own single-producer ring of records, so logging
+ * threads never contend with each other or wait on I/O.  A background
+ * flusher drains the rings, puts the records in posting order, and is the
+ * only thread that ever writes to the sink.
+ *
+ * There are two ways in:
+ *
+ *  - post() / ALOG_xxx copies its arguments into the ring and the flusher
+ *    formats them later, so the caller pays for a few stores, not for the
+ *    formatting.  One post is one line; don't pass std::endl.
+ *
+ *  - stream() is an ostream for the usual "out << LOG_INFO << ... << endl"
+ *    logging.  It formats in the caller and posts each line when it is
+ *    flushed.  Every thread writing to it has its own line buffer, so the
+ *    one stream can be handed to worker threads (a World's evaluators, say)
+ *    without their lines running together.  Its format flags are shared,
+ *    though, so leave them alone once there is more than one writer.  A
+ *    partial line a thread never flushes is dropped when the thread exits.
+ *
+ * A full ring makes its producer yield until the flusher catches up; we
+ * slow down rather than drop log lines.  When a thread exits, its ring is
+ * retired, and the flusher drops it once it has drained it, so short-lived
+ * worker threads don't pile up rings.  Deferred arguments are copied by
+ * value, and C strings are copied into std::strings, since a buffer may be
+ * gone by the time the flusher gets to it.
+ */
+// --------------------------------------------------------------------------
+class AsyncLog
+{
+public:
+    static constexpr size_t SLOT_BYTES = 192;           ///< Room for deferred arguments
+
+
+    /**
+     * Starts the flusher for a sink
+     *
+     * @param sink          Where the log lines end up
+     * @param ringSlots     Records per thread ring (rounded up to a power of 2)
+     *///--------------------------------------------------------------------
+    explicit AsyncLog(std::ostream& sink, size_t ringSlots = 1024)
+    : id_        (nextId()),
+      sink_      (sink),
+      ringSlots_ (roundUp(ringSlots)),
+      nextSeq_   (0),
+      numWritten_(0),
+      numStalls_ (0),
+      isRunning_ (true),
+      lineBuf_   (*this),
+      stream_    (&lineBuf_)
+    {
+        stream_.copyfmt(sink);
+        flusher_ = boost::thread(&AsyncLog::flushLoop, this);
+    }
+
+
+    /**
+     * Writes everything out and stops the flusher
+     *///--------------------------------------------------------------------
+    ~AsyncLog()
+    {
+        stream_.flush();
+        {
+            boost::lock_guard<boost::mutex> lock(lock_);
+            isRunning_ = false;
+        }
+        wakeFlusher_.notify_all();
+        flusher_.join();
+    }
+
+
+    AsyncLog(const AsyncLog& that) = delete;                ///< DISABLED!
+    AsyncLog & operator=(const AsyncLog& rhs) = delete;     ///< DISABLED!
+
+
+    /**
+     * Queues one log line.  The arguments are streamed to the sink (in
+     * order, followed by a newline) by the flusher.
+     *///--------------------------------------------------------------------
+    template<class... Args>
+    void post(Args&&... args)
+    {
+        using Pack = std::tuple<typename Stored<Args>::type...>;
+
+        Ring&   ring = myRing();
+        Record& rec  = ring.claim(*this);
+
+        fill<Pack>(rec, std::integral_constant<bool, (sizeof(Pack)  <= SLOT_BYTES) &&
+                                                     (alignof(Pack) <= alignof(std::max_align_t))>(),
+                   std::forward<Args>(args)...);
+        rec.seq_ = nextSeq_.fetch_add(1, std::memory_order_relaxed);
+        ring.publish();
+    }
+
+
+    /**
+     * Returns the line-buffered stream (any thread may write to it)
+     *///--------------------------------------------------------------------
+    std::ostream& stream()
+    {
+        return stream_;
+    }
+
+
+    /**
+     * Blocks until every line posted so far has been written and the sink
+     * has been flushed
+     *///--------------------------------------------------------------------
+    void flush()
+    {
+        stream_.flush();
+
+        uint64_t                         target = nextSeq_.load();
+        boost::unique_lock<boost::mutex> lock(lock_);
+
+        wakeFlusher_.notify_all();
+        while(numWritten_ < target)
+        {
+            written_.wait(lock);
+        }
+    }
+
+
+    /**
+     * Returns how many times a producer found its ring full
+     *///--------------------------------------------------------------------
+    uint64_t getNumStalls() const
+    {
+        return numStalls_.load();
+    }
+
+
+private:
+    /**
+     * How we keep a deferred argument: by value, with C strings copied
+     */
+    template<class T>
+    struct Stored
+    {
+        using D    = typename std::decay<T>::type;
+        using type = typename std::conditional<std::is_same<D, char*>::value ||
+                                               std::is_same<D, const char*>::value,
+                                               std::string, D>::type;
+    };
+
+    /**
+     * A queued log line: deferred arguments plus how to format and free them
+     */
+    struct Record
+    {
+        uint64_t        seq_;                               ///< Posting order
+        void          (*format_)(std::ostream&, void*);     ///< Streams the payload
+        void          (*destroy_)(void*);                   ///< Frees the payload
+        alignas(std::max_align_t) unsigned char payload_[SLOT_BYTES];
+    };
+
+    /**
+     * Single-producer, single-consumer ring for one logging thread
+     */
+    struct Ring
+    {
+        std::unique_ptr<Record[]>   slots_;                 ///< Ring storage
+        size_t                      mask_;                  ///< Slot count - 1
+        std::atomic<size_t>         head_;                  ///< Next slot to fill (producer)
+        char                        pad_[64];               ///< Keep head_ and tail_ on separate lines
+        std::atomic<size_t>         tail_;                  ///< Next slot to drain (flusher)
+        std::atomic<bool>           isRetired_;             ///< Producer is gone; drop once drained
+
+        explicit Ring(size_t numSlots)
+        : slots_(new Record[numSlots]), mask_(numSlots - 1), head_(0), tail_(0), isRetired_(false)
+        { }
+
+        Record& claim(AsyncLog& log)
+        {
+            size_t head = head_.load(std::memory_order_relaxed);
+
+            if(head - tail_.load(std::memory_order_acquire) > mask_)
+            {
+                ++log.numStalls_;
+                log.wakeFlusher_.notify_one();
+                while(head - tail_.load(std::memory_order_acquire) > mask_)
+                {
+                    boost::this_thread::yield();
+                }
+            }
+            return slots_[head & mask_];
+        }
+
+        void publish()
+        {
+            head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+    };
+
+    /**
+     * A thread's ring, remembered per thread.  Retires the ring when the
+     * thread exits (or moves on to another AsyncLog).
+     */
+    struct MyRing
+    {
+        uint64_t                owner_ = 0;         ///< Id of the ring's AsyncLog (0 for none)
+        std::shared_ptr<Ring>   ring_;              ///< Shared with the AsyncLog's list
+        std::string             line_;              ///< This thread's stream() line so far
+
+        ~MyRing()
+        {
+            retire();
+        }
+
+        void retire()
+        {
+            if(ring_)
+            {
+                ring_->isRetired_.store(true, std::memory_order_release);
+                ring_.reset();
+            }
+            line_.clear();
+            owner_ = 0;
+        }
+    };
+
+    /**
+     * Buffer behind stream().  It has no put area of its own: text goes
+     * straight to the writing thread's line, which is posted on flush.
+     */
+    class LineBuf : public std::streambuf
+    {
+    public:
+        explicit LineBuf(AsyncLog& log) : log_(log) { }
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if(!traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                log_.myLine().push_back(traits_type::to_char_type(c));
+            }
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char *s, std::streamsize n) override
+        {
+            log_.myLine().append(s, n);
+            return n;
+        }
+
+        int sync() override
+        {
+            std::string& line = log_.myLine();
+
+            if(!line.empty())
+            {
+                log_.post(RawText { std::move(line) });
+                line.clear();
+            }
+            return 0;
+        }
+
+    private:
+        AsyncLog& log_;
+    };
+
+    /**
+     * Already formatted text (from stream() or an oversized post)
+     */
+    struct RawText
+    {
+        std::string text_;
+    };
+
+    uint64_t                            id_;            ///< Tells AsyncLogs apart, even at one address
+    std::ostream&                       sink_;          ///< Where the lines go
+    size_t                              ringSlots_;     ///< Records per ring
+    std::atomic<uint64_t>               nextSeq_;       ///< Next posting sequence number
+    uint64_t                            numWritten_;    ///< Records written (under lock_)
+    std::atomic<uint64_t>               numStalls_;     ///< Producer stalls on a full ring
+    bool                                isRunning_;     ///< Cleared on shutdown (under lock_)
+    std::vector<std::shared_ptr<Ring>>  rings_;         ///< One per logging thread (under lock_)
+    boost::mutex                        lock_;          ///< Guards the ring list and counters
+    boost::condition_variable           wakeFlusher_;   ///< Flusher sleeps here
+    boost::condition_variable           written_;       ///< flush() waits here
+    boost::thread                       flusher_;       ///< Background writer
+    LineBuf                             lineBuf_;       ///< stream()'s buffer
+    std::ostream                        stream_;        ///< Line-buffered front end
+
+
+    static size_t roundUp(size_t n)
+    {
+        size_t p = 2;
+
+        while(p < n)
+        {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static uint64_t nextId()
+    {
+        static std::atomic<uint64_t> lastId(0);
+
+        return ++lastId;
+    }
+
+    static MyRing& myHolder()
+    {
+        static thread_local MyRing mine;
+
+        return mine;
+    }
+
+    std::string& myLine()
+    {
+        myRing();
+        return myHolder().line_;
+    }
+
+    Ring& myRing()
+    {
+        MyRing& mine = myHolder();
+
+        if(mine.owner_ != id_)
+        {
+            auto ring = std::make_shared<Ring>(ringSlots_);
+
+            mine.retire();
+            {
+                boost::lock_guard<boost::mutex> lock(lock_);
+                rings_.push_back(ring);
+            }
+            mine.ring_  = ring;
+            mine.owner_ = id_;
+        }
+        return *mine.ring_;
+    }
+
+    template<class Pack, class... Args>
+    static void fill(Record& rec, std::true_type, Args&&... args)
+    {
+        new (rec.payload_) Pack(std::forward<Args>(args)...);
+        rec.format_  = &formatPack<Pack>;
+        rec.destroy_ = &destroyPack<Pack>;
+    }
+
+    template<class Pack, class... Args>
+    static void fill(Record& rec, std::false_type, Args&&... args)
+    {
+        std::ostringstream line;
+        int                dummy[] = { 0, ((void) (line << args), 0)... };
+
+        (void) dummy;
+        line << '\n';
+        fill<std::tuple<RawText>>(rec, std::true_type(), RawText { line.str() });
+    }
+
+    template<class Pack>
+    static void formatPack(std::ostream& out, void *payload)
+    {
+        streamPack(out, *static_cast<Pack*>(payload),
+                   std::make_index_sequence<std::tuple_size<Pack>::value>());
+    }
+
+    template<class Pack, size_t... I>
+    static void streamPack(std::ostream& out, Pack& pack, std::index_sequence<I...>)
+    {
+        int dummy[] = { 0, ((void) put(out, std::get<I>(pack)), 0)... };
+
+        (void) dummy;
+        if(!isRaw(pack))
+        {
+            out << '\n';
+        }
+    }
+
+    template<class T>
+    static void put(std::ostream& out, const T& arg)        { out << arg; }
+    static void put(std::ostream& out, const RawText& raw)  { out << raw.text_; }
+
+    static bool isRaw(const std::tuple<RawText>&)           { return true; }
+    template<class Pack>
+    static bool isRaw(const Pack&)                          { return false; }
+
+    template<class Pack>
+    static void destroyPack(void *payload)
+    {
+        static_cast<Pack*>(payload)->~Pack();
+    }
+
+
+    /*
+     * Background flusher: gather what every ring has, write it in posting
+     * order, then free the slots.
+     */
+    void flushLoop()
+    {
+        std::vector<std::pair<Record*, Ring*>> batch;
+        std::vector<Ring*>                     rings;
+
+        for(;;)
+        {
+            bool isRunning;
+            {
+                boost::unique_lock<boost::mutex> lock(lock_);
+
+                rings.clear();
+                for(auto& r : rings_)
+                {
+                    rings.push_back(r.get());
+                }
+                isRunning = isRunning_;
+            }
+
+            batch.clear();
+            for(Ring *ring : rings)
+            {
+                size_t head = ring->head_.load(std::memory_order_acquire);
+
+                for(size_t i = ring->tail_.load(std::memory_order_relaxed); i != head; ++i)
+                {
+                    batch.emplace_back(&ring->slots_[i & ring->mask_], ring);
+                }
+            }
+
+            if(batch.empty())
+            {
+                boost::unique_lock<boost::mutex> lock(lock_);
+
+                dropRetired();
+                if(!isRunning)
+                {
+                    break;
+                }
+                wakeFlusher_.timed_wait(lock, boost::posix_time::milliseconds(20));
+                continue;
+            }
+
+            std::sort(batch.begin(), batch.end(),
+                      [](const std::pair<Record*, Ring*>& a,
+                         const std::pair<Record*, Ring*>& b) { return a.first->seq_ < b.first->seq_; });
+
+            for(auto& item : batch)
+            {
+                item.first->format_(sink_, item.first->payload_);
+                item.first->destroy_(item.first->payload_);
+                item.second->tail_.fetch_add(1, std::memory_order_release);
+            }
+            sink_.flush();
+
+            boost::lock_guard<boost::mutex> lock(lock_);
+            numWritten_ += batch.size();
+            written_.notify_all();
+            dropRetired();
+        }
+    }
+
+
+    /*
+     * Drops the rings of threads that have exited, once they are drained.
+     * Flusher only, under lock_.
+     */
+    void dropRetired()
+    {
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                    [](const std::shared_ptr<Ring>& ring)
+                                    {
+                                        return ring->isRetired_.load(std::memory_order_acquire)
+                                            && (ring->tail_.load(std::memory_order_relaxed) ==
+                                                ring->head_.load(std::memory_order_acquire));
+                                    }),
+                     rings_.end());
+    }
+};
+
+
+} } // ns{ oi::util }
+
+#endif	/* ASYNCLOG_HPP */
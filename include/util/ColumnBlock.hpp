@@ -0,0 +1,321 @@
+/*\***********************************************************************\*//**
+ * MODULE: ColumnBlock.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef COLUMNBLOCK_HPP
+#define	COLUMNBLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ostrich.hpp"
+
+namespace oi { namespace util {
+
+
+// --------------------------------------------------------------------------
+// ColumnBlock:
+// --------------------------------------------------------------------------
+/**
+ * A flat, columnar block of Real data that lives in memory we don't own: a
+ * shared memory segment, a memory-mapped file, or plain old heap.  Nothing
+ * in the block is a pointer, so any process that maps it may read it as-is.
+ *
+ *      +--------+----------------------+----------+----------+-----
+ *      | Header | Directory[numCols_]  | Column 0 | Column 1 | ...
+ *      +--------+----------------------+----------+----------+-----
+ *
+ * Every column holds capacity_ rows (of which numRows_ are valid) and starts
+ * on a cache line boundary.  The ColumnBlock object itself is just a view;
+ * it is cheap to copy and never frees the memory.
+ */
+// --------------------------------------------------------------------------
+class ColumnBlock
+{
+public:
+    static constexpr uint32_t MAGIC     = 0x53425943;       ///< "CYBS" on little-endian
+    static constexpr uint16_t VERSION   = 1;                ///< Bump when the layout changes
+    static constexpr size_t   NAME_LEN  = 24;               ///< Max column name (with '\0')
+    static constexpr size_t   TAG_LEN   = 32;               ///< Max block tag (with '\0')
+    static constexpr size_t   ALIGNMENT = 64;               ///< Column alignment (cache line)
+
+    /**
+     * Fixed block header
+     *///--------------------------------------------------------------------
+    struct Header
+    {
+        uint32_t                magic_;         ///< MAGIC when formatted
+        uint16_t                version_;       ///< Layout VERSION
+        uint16_t                numCols_;       ///< Attribute columns in block
+        uint32_t                numRows_;       ///< Valid rows in each column
+        uint32_t                capacity_;      ///< Allocated rows in each column
+        int64_t                 stamp_;         ///< Owner-defined validity stamp (e.g., last update)
+        std::atomic<uint32_t>   ready_;         ///< Non-zero once the writer is finished
+        uint32_t                realSize_;      ///< sizeof(Real) of the writer
+        char                    tag_[TAG_LEN];  ///< Owner-defined tag (e.g., symbol)
+    };
+
+    /**
+     * Column directory entry
+     *///--------------------------------------------------------------------
+    struct DirEntry
+    {
+        char        name_[NAME_LEN];            ///< Attribute name
+        uint64_t    offset_;                    ///< Byte offset of column from block start
+    };
+
+
+    /**
+     * Creates an empty (invalid) view
+     *///--------------------------------------------------------------------
+    ColumnBlock()
+    : base_(NULL)
+    { }
+
+
+    /**
+     * Creates a view on memory that already holds a formatted block.  Use
+     * isValid() to check that it was what we expected, and that it fits.
+     *
+     * @param mem   Start of the block
+     *///--------------------------------------------------------------------
+    explicit ColumnBlock(void *mem)
+    : base_(static_cast<char*>(mem))
+    { }
+
+
+    /**
+     * Returns the number of bytes needed for a block with the specified
+     * dimensions.
+     *
+     * @param numCols   Number of attribute columns
+     * @param capacity  Number of rows to allocate in each column
+     *
+     * @return          Byte size of the block
+     *///--------------------------------------------------------------------
+    static size_t sizeFor(size_t numCols, size_t capacity)
+    {
+        return dataOffset(numCols) + (numCols * colBytes(capacity));
+    }
+
+
+    /**
+     * Lays out a new, empty block in the specified memory, which must be at
+     * least sizeFor(names.size(), capacity) bytes.  The block is not ready
+     * until the writer calls setReady().
+     *
+     * @param mem       Start of the block
+     * @param names     Attribute names, one per column
+     * @param capacity  Number of rows to allocate in each column
+     * @param stamp     Owner-defined validity stamp
+     * @param tag       Owner-defined tag
+     *
+     * @return          A view on the newly formatted block
+     *///--------------------------------------------------------------------
+    static ColumnBlock format(void                           *mem,
+                              const std::vector<std::string>& names,
+                              size_t                          capacity,
+                              int64_t                         stamp,
+                              const std::string&              tag)
+    {
+        ColumnBlock block(mem);
+        Header     *hdr = block.header();
+
+        memset(mem, 0, dataOffset(names.size()));
+        hdr->magic_    = MAGIC;
+        hdr->version_  = VERSION;
+        hdr->numCols_  = names.size();
+        hdr->numRows_  = 0;
+        hdr->capacity_ = capacity;
+        hdr->stamp_    = stamp;
+        hdr->realSize_ = sizeof(Real);
+        hdr->ready_.store(0, std::memory_order_relaxed);
+        strncpy(hdr->tag_, tag.c_str(), TAG_LEN - 1);
+
+        for(size_t c = 0; c < names.size(); ++c)
+        {
+            DirEntry& entry = block.dir()[c];
+
+            strncpy(entry.name_, names[c].c_str(), NAME_LEN - 1);
+            entry.offset_ = dataOffset(names.size()) + (c * colBytes(capacity));
+        }
+        return block;
+    }
+
+
+    /**
+     * Returns true if the view points to a block in a layout we understand,
+     * and that fits in the memory behind it.  Check this before trusting
+     * anything else in a block someone else wrote.
+     *
+     * @param length    Bytes mapped (or allocated) at the start of the block
+     *///--------------------------------------------------------------------
+    bool isValid(size_t length) const
+    {
+        if(!base_
+            || (length               <  sizeof(Header))
+            || (MAGIC                != header()->magic_)
+            || (VERSION              != header()->version_)
+            || (sizeof(Real)         != header()->realSize_)
+            || (header()->numRows_   >  header()->capacity_)
+            || (memchr(header()->tag_, '\0', TAG_LEN) == NULL)
+            || (sizeFor(header()->numCols_, header()->capacity_) > length))
+        {
+            return false;
+        }
+
+        // The directory must describe the layout we would have made
+        for(size_t c = 0; c < getNumCols(); ++c)
+        {
+            const DirEntry& entry = dir()[c];
+
+            if((memchr(entry.name_, '\0', NAME_LEN) == NULL)
+                || (entry.offset_ != dataOffset(getNumCols()) + (c * colBytes(getCapacity()))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    /**
+     * Returns true once the writer has finished filling the block.
+     *///--------------------------------------------------------------------
+    bool isReady() const
+    {
+        return header()->ready_.load(std::memory_order_acquire);
+    }
+
+
+    /**
+     * Publishes the block to readers.  Any column data written before this
+     * call is visible to a reader once isReady() returns true.
+     *///--------------------------------------------------------------------
+    void setReady()
+    {
+        header()->ready_.store(1, std::memory_order_release);
+    }
+
+
+    size_t      getNumCols()  const { return header()->numCols_;  }    ///< Column count
+    size_t      getNumRows()  const { return header()->numRows_;  }    ///< Valid rows per column
+    size_t      getCapacity() const { return header()->capacity_; }    ///< Allocated rows per column
+    int64_t     getStamp()    const { return header()->stamp_;    }    ///< Validity stamp
+    std::string getTag()      const { return header()->tag_;      }    ///< Block tag
+
+    /**
+     * Sets the number of valid rows in each column (writers only)
+     *///--------------------------------------------------------------------
+    void setNumRows(size_t numRows)
+    {
+        header()->numRows_ = numRows;
+    }
+
+
+    /**
+     * Sets the validity stamp (writers only)
+     *///--------------------------------------------------------------------
+    void setStamp(int64_t stamp)
+    {
+        header()->stamp_ = stamp;
+    }
+
+
+    /**
+     * Returns the name of a column
+     *
+     * @param col   Column index
+     *///--------------------------------------------------------------------
+    std::string getName(size_t col) const
+    {
+        return dir()[col].name_;
+    }
+
+
+    /**
+     * Returns the index for the named column
+     *
+     * @param name  Attribute name
+     *
+     * @return      The column index, or -1 if there is no such column
+     *///--------------------------------------------------------------------
+    int findColumn(const std::string& name) const
+    {
+        for(size_t c = 0; c < getNumCols(); ++c)
+        {
+            if(name == dir()[c].name_)
+            {
+                return c;
+            }
+        }
+        return -1;
+    }
+
+
+    /**
+     * Returns the data for a column.  Rows are oldest first.
+     *
+     * @param col   Column index
+     *///--------------------------------------------------------------------
+    const Real *column(size_t col) const
+    {
+        return reinterpret_cast<const Real*>(base_ + dir()[col].offset_);
+    }
+
+
+    /**
+     * Returns the writable data for a column (writers only)
+     *
+     * @param col   Column index
+     *///--------------------------------------------------------------------
+    Real *column(size_t col)
+    {
+        return reinterpret_cast<Real*>(base_ + dir()[col].offset_);
+    }
+
+
+    /**
+     * Returns the total size of the block in bytes
+     *///--------------------------------------------------------------------
+    size_t getByteSize() const
+    {
+        return sizeFor(getNumCols(), getCapacity());
+    }
+
+
+private:
+    char   *base_;              ///< Start of block (we don't own it)
+
+    Header         *header()       { return reinterpret_cast<Header*>(base_); }
+    const Header   *header() const { return reinterpret_cast<const Header*>(base_); }
+    DirEntry       *dir()          { return reinterpret_cast<DirEntry*>(base_ + sizeof(Header)); }
+    const DirEntry *dir()    const { return reinterpret_cast<const DirEntry*>(base_ + sizeof(Header)); }
+
+    static size_t align(size_t n)
+    {
+        return (n + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    static size_t colBytes(size_t capacity)
+    {
+        return align(capacity * sizeof(Real));
+    }
+
+    static size_t dataOffset(size_t numCols)
+    {
+        return align(sizeof(Header) + (numCols * sizeof(DirEntry)));
+    }
+};
+
+
+} } // ns{ oi::util }
+
+#endif	/* COLUMNBLOCK_HPP */
@@ -0,0 +1,186 @@
+/*\***********************************************************************\*//**
+ * MODULE: HardwareProbe.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef HARDWAREPROBE_HPP
+#define	HARDWAREPROBE_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <glob.h>
+#include <unistd.h>
+
+namespace oi { namespace util {
+
+
+// --------------------------------------------------------------------------
+// HardwareProbe:
+// --------------------------------------------------------------------------
+/**
+ * Finds out what the node we are running on can do: the widest SIMD
+ * instruction set, the data cache sizes, the NUMA topology and the memory.
+ * Our cluster nodes are not all alike, so the evaluation engine is tuned
+ * from this rather than by hand (see genprog::Tuning).
+ *
+ * Cache and NUMA information comes from sysfs (falling back on sysconf for
+ * the caches).  Anything a machine does not tell us comes back as zero, or
+ * as one NUMA node.
+ */
+// --------------------------------------------------------------------------
+class HardwareProbe
+{
+public:
+    enum SIMD
+    {
+        SIMD_NONE,
+        SIMD_SSE2,
+        SIMD_AVX2,
+        SIMD_AVX512,
+        NUM_SIMDS
+    };
+
+
+    /**
+     * What the probe found
+     */
+    struct Info
+    {
+        int     cores_;             ///< Online CPUs
+        SIMD    simd_;              ///< Widest usable SIMD level
+        size_t  l1dBytes_;          ///< L1 data cache per core
+        size_t  l2Bytes_;           ///< L2 cache
+        size_t  l3Bytes_;           ///< Last-level (L3) cache, or 0 if none
+        int     numaNodes_;         ///< NUMA nodes (1 if not NUMA)
+        size_t  memTotalBytes_;     ///< Physical memory
+        size_t  memAvailBytes_;     ///< Memory available for new work
+    };
+
+
+    /**
+     * Probes the node
+     *///--------------------------------------------------------------------
+    static Info probe()
+    {
+        Info info = { };
+
+        info.cores_     = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+        info.simd_      = getSIMD();
+        info.numaNodes_ = std::max<int>(1, glob("/sys/devices/system/node/node[0-9]*").size());
+
+        // Caches, as CPU 0 sees them
+        for(auto& dir : glob("/sys/devices/system/cpu/cpu0/cache/index[0-9]*"))
+        {
+            std::string type  = readText(dir + "/type");
+            int         level = std::atoi(readText(dir + "/level").c_str());
+            size_t      size  = readSize(dir + "/size");
+
+            if(type == "Instruction")   continue;
+            else if(1 == level)         info.l1dBytes_ = size;
+            else if(2 == level)         info.l2Bytes_  = size;
+            else if(3 == level)         info.l3Bytes_  = size;
+        }
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+        if(!info.l1dBytes_) info.l1dBytes_ = std::max(0L, sysconf(_SC_LEVEL1_DCACHE_SIZE));
+        if(!info.l2Bytes_)  info.l2Bytes_  = std::max(0L, sysconf(_SC_LEVEL2_CACHE_SIZE));
+        if(!info.l3Bytes_)  info.l3Bytes_  = std::max(0L, sysconf(_SC_LEVEL3_CACHE_SIZE));
+#endif
+
+        // Memory: MemAvailable counts the page cache the kernel can give back
+        size_t pageSize = sysconf(_SC_PAGESIZE);
+
+        info.memTotalBytes_ = pageSize * sysconf(_SC_PHYS_PAGES);
+        info.memAvailBytes_ = pageSize * sysconf(_SC_AVPHYS_PAGES);
+
+        std::ifstream meminfo("/proc/meminfo");
+        std::string   key;
+        size_t        kb;
+
+        while(meminfo >> key >> kb)
+        {
+            if(key == "MemAvailable:")
+            {
+                info.memAvailBytes_ = kb * 1024;
+                break;
+            }
+            meminfo.ignore(64, '\n');
+        }
+        return info;
+    }
+
+
+    /**
+     * Returns the widest SIMD instruction set this CPU supports
+     *///--------------------------------------------------------------------
+    static SIMD getSIMD()
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))   return SIMD_AVX512;
+        if(__builtin_cpu_supports("avx2"))      return SIMD_AVX2;
+        if(__builtin_cpu_supports("sse2"))      return SIMD_SSE2;
+#endif
+        return SIMD_NONE;
+    }
+
+
+    /**
+     * Returns the name of a SIMD level, for logs and the tuning file
+     *///--------------------------------------------------------------------
+    static const char* getSIMDName(SIMD simd)
+    {
+        static const char *NAMES[NUM_SIMDS] = { "none", "sse2", "avx2", "avx512" };
+
+        return NAMES[simd];
+    }
+
+
+private:
+    static std::vector<std::string> glob(const std::string& pattern)
+    {
+        std::vector<std::string> paths;
+        glob_t                   found = { };
+
+        if(0 == ::glob(pattern.c_str(), 0, NULL, &found))
+        {
+            paths.assign(found.gl_pathv, found.gl_pathv + found.gl_pathc);
+        }
+        globfree(&found);
+        return paths;
+    }
+
+    static std::string readText(const std::string& path)
+    {
+        std::ifstream in(path.c_str());
+        std::string   text;
+
+        in >> text;
+        return text;
+    }
+
+    static size_t readSize(const std::string& path)
+    {
+        std::string text = readText(path);     // e.g., "32K", "1024K", "32M"
+        size_t      size = std::strtoul(text.c_str(), NULL, 10);
+
+        switch(text.empty() ? '\0' : text.back())
+        {
+            case 'K':   return size << 10;
+            case 'M':   return size << 20;
+            case 'G':   return size << 30;
+            default:    return size;
+        }
+    }
+};
+
+
+} } // ns{ oi::util }
+
+#endif	/* HARDWAREPROBE_HPP */
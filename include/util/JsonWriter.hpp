@@ -0,0 +1,519 @@
+/*\***********************************************************************\*//**
+ * MODULE: JsonWriter.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef JSONWRITER_HPP
+#define	JSONWRITER_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <locale.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "ostrich.hpp"
+
+namespace oi { namespace util {
+
+
+// --------------------------------------------------------------------------
+// JsonWriter:
+// --------------------------------------------------------------------------
+/**
+ * Streaming JSON writer.  Output goes through one fixed buffer straight to
+ * the target, so a document of any size costs the same memory, and nothing
+ * is built up as a string or a DOM first.  The writer inserts the commas;
+ * callers just nest begin/end calls:
+ *
+ *      JsonWriter json(SHAREDSTATEDIR "/www/SPY.json");
+ *
+ *      json.beginObject()
+ *              .field("symbol", "SPY")
+ *              .key("prophecy").beginArray();
+ *      for(auto p : prophecy) json.value(p);
+ *      json.endArray()
+ *          .endObject()
+ *          .commit();
+ *
+ * A file target is written to a private temp file (mkstemp) next to the
+ * real file and renamed over it by commit(), so a reader sees either the old
+ * document or the new one, never part of one, and two writers of the same
+ * path never share a temp file.  The directory is synced after the rename,
+ * so the replacement survives a crash too.  A writer destroyed without
+ * commit() throws its temp file away.  A string target simply appends.
+ *
+ * Misuse throws std::logic_error rather than producing bad JSON: a bracket
+ * that doesn't match its opener, a key outside an object or without its
+ * value, an object member without a key, or a second top-level value.
+ *
+ * Reals go out in the shortest form that reads back as exactly the same
+ * value, using up to max_digits10 significant digits by default, and always
+ * with a '.' whatever the process locale.
+ *
+ * So far only the benchmark reports (sibyl --bench, sibyl-bench --json) are
+ * written this way.  Prognosticator still writes the prophecy and www files
+ * itself.
+ */
+// --------------------------------------------------------------------------
+class JsonWriter
+{
+public:
+    static constexpr size_t BUF_SIZE  = 16 * 1024;      ///< Output buffer
+    static constexpr int    MAX_DEPTH = 32;             ///< Object/array nesting limit
+
+
+    /**
+     * Starts a JSON file
+     *
+     * @param path      The file to (atomically) replace on commit()
+     * @param precision Significant digits for Real values (by default,
+     *                  enough to read back the exact same value)
+     *///--------------------------------------------------------------------
+    explicit JsonWriter(const std::string& path, int precision = std::numeric_limits<Real>::max_digits10)
+    : path_     (path),
+      tmpPath_  (path + ".XXXXXX"),
+      fd_       (mkstemp(&tmpPath_[0])),
+      str_      (NULL),
+      precision_(precision)
+    {
+        if(fd_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "Cannot create a temp file for " + path_);
+        }
+        fchmod(fd_, 0644);                  // mkstemp's 0600 would hide it from the web server
+        init();
+    }
+
+
+    /**
+     * Starts a JSON document in a string
+     *
+     * @param str       The document is appended here
+     * @param precision Significant digits for Real values (by default,
+     *                  enough to read back the exact same value)
+     *///--------------------------------------------------------------------
+    explicit JsonWriter(std::string& str, int precision = std::numeric_limits<Real>::max_digits10)
+    : fd_       (-1),
+      str_      (&str),
+      precision_(precision)
+    {
+        init();
+    }
+
+
+    /**
+     * Drops an uncommitted file
+     *///--------------------------------------------------------------------
+    ~JsonWriter()
+    {
+        if(fd_ >= 0)
+        {
+            close(fd_);
+            unlink(tmpPath_.c_str());
+        }
+    }
+
+
+    JsonWriter(const JsonWriter& that) = delete;                ///< DISABLED!
+    JsonWriter & operator=(const JsonWriter& rhs) = delete;     ///< DISABLED!
+
+
+    JsonWriter& beginObject()   { return openLevel('{');  }     ///< Starts {...}
+    JsonWriter& endObject()     { return closeLevel('}'); }     ///< Ends {...}
+    JsonWriter& beginArray()    { return openLevel('[');  }     ///< Starts [...]
+    JsonWriter& endArray()      { return closeLevel(']'); }     ///< Ends [...]
+
+
+    /**
+     * Writes an object member's name.  Its value comes next.
+     *///--------------------------------------------------------------------
+    JsonWriter& key(const char *name)
+    {
+        if(!depth_ || ('}' != closers_[depth_]) || isKeyed_)
+        {
+            throw std::logic_error("JSON key outside an object, or without a value");
+        }
+        if(hasItems_[depth_])
+        {
+            put(',');
+        }
+        hasItems_[depth_] = true;
+        putString(name, strlen(name));
+        put(':');
+        isKeyed_ = true;
+        return *this;
+    }
+
+
+    JsonWriter& key(const std::string& name)    { return key(name.c_str()); }
+
+
+    /**
+     * Writes a Real value.  NaN and infinities aren't JSON, so they go out
+     * as null.
+     *///--------------------------------------------------------------------
+    JsonWriter& value(Real val)
+    {
+        separate();
+        if(std::isfinite(val))
+        {
+            reserve(32);
+            len_ += formatReal(buf_ + len_, val);
+        }
+        else
+        {
+            putRaw("null", 4);
+        }
+        return *this;
+    }
+
+
+    /**
+     * Writes an integer value
+     *///--------------------------------------------------------------------
+    JsonWriter& value(int64_t val)
+    {
+        char  digits[24];
+        char *end = digits + sizeof(digits);
+        char *p   = end;
+        bool  neg = (val < 0);
+        uint64_t u = neg ? (0 - (uint64_t) val) : (uint64_t) val;
+
+        separate();
+        do
+        {
+            *--p = '0' + (u % 10);
+            u   /= 10;
+        } while(u);
+        if(neg)
+        {
+            *--p = '-';
+        }
+        putRaw(p, end - p);
+        return *this;
+    }
+
+
+    JsonWriter& value(int val)                  { return value((int64_t) val); }
+    JsonWriter& value(u_int val)                { return value((int64_t) val); }
+    JsonWriter& value(size_t val)               { return value((int64_t) val); }
+
+
+    /**
+     * Writes a boolean value
+     *///--------------------------------------------------------------------
+    JsonWriter& value(bool val)
+    {
+        separate();
+        return val ? putRaw("true", 4) : putRaw("false", 5);
+    }
+
+
+    /**
+     * Writes a string value
+     *///--------------------------------------------------------------------
+    JsonWriter& value(const char *val)
+    {
+        separate();
+        putString(val, strlen(val));
+        return *this;
+    }
+
+
+    JsonWriter& value(const std::string& val)
+    {
+        separate();
+        putString(val.data(), val.size());
+        return *this;
+    }
+
+
+    /**
+     * Writes a null value
+     *///--------------------------------------------------------------------
+    JsonWriter& null()
+    {
+        separate();
+        return putRaw("null", 4);
+    }
+
+
+    /**
+     * Writes an object member: key(name).value(val)
+     *///--------------------------------------------------------------------
+    template<typename T>
+    JsonWriter& field(const char *name, const T& val)
+    {
+        key(name);
+        return value(val);
+    }
+
+
+    /**
+     * Finishes the document.  A file target is flushed, synced, and renamed
+     * over the real file, and then its directory is synced so the rename
+     * itself is durable.
+     *///--------------------------------------------------------------------
+    void commit()
+    {
+        if(depth_ || !hasItems_[0])
+        {
+            throw std::logic_error("Unterminated (or empty) JSON document");
+        }
+        put('\n');
+        flush();
+
+        if(fd_ >= 0)
+        {
+            int rc = fsync(fd_);
+
+            rc |= close(fd_);
+            fd_ = -1;
+            if((rc != 0) || (rename(tmpPath_.c_str(), path_.c_str()) != 0))
+            {
+                int err = errno;
+
+                unlink(tmpPath_.c_str());
+                throw std::system_error(err, std::generic_category(), "Cannot replace " + path_);
+            }
+            syncDir();
+        }
+    }
+
+
+private:
+    /**
+     * Formats a finite Real with the fewest significant digits (up to
+     * precision_) that read back as the same value, as to_chars would.
+     * snprintf and strtod run in the C locale (for this thread only), so
+     * the decimal point is always a '.'.
+     *
+     * @return  Characters written (room for 32 is needed)
+     *///--------------------------------------------------------------------
+    int formatReal(char *out, Real val) const
+    {
+        static const locale_t C_LOCALE = newlocale(LC_NUMERIC_MASK, "C", (locale_t) 0);
+
+        locale_t prevLocale = uselocale(C_LOCALE);
+        int      len        = 0;
+
+        for(int digits = std::min(precision_, std::numeric_limits<Real>::digits10); digits <= precision_; ++digits)
+        {
+            len = snprintf(out, 32, "%.*g", digits, (double) val);
+            if((Real) strtod(out, NULL) == val)
+            {
+                break;
+            }
+        }
+        uselocale(prevLocale);
+        return len;
+    }
+
+
+    /**
+     * Syncs the directory holding the final file, so the rename sticks
+     *///--------------------------------------------------------------------
+    void syncDir() const
+    {
+        size_t      slash = path_.rfind('/');
+        std::string dir   = (std::string::npos == slash) ? "."
+                          : (0 == slash)                 ? "/"
+                                                         : path_.substr(0, slash);
+        int         dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+        int         rc    = (dirFd < 0) ? -1 : fsync(dirFd);
+        int         err   = errno;
+
+        if(dirFd >= 0)
+        {
+            close(dirFd);
+        }
+        if(rc != 0)
+        {
+            throw std::system_error(err, std::generic_category(), "Cannot sync directory " + dir);
+        }
+    }
+
+    std::string     path_;                  ///< Final file
+    std::string     tmpPath_;               ///< File we write until commit()
+    int             fd_;                    ///< Temp file (or -1 for a string target)
+    std::string    *str_;                   ///< String target (or NULL)
+    int             precision_;             ///< Significant digits for Reals
+    int             depth_;                 ///< Current nesting level
+    bool            isKeyed_;               ///< Just wrote a key; no comma before the value
+    bool            hasItems_[MAX_DEPTH];   ///< Per level: need a comma before the next item?
+    char            closers_[MAX_DEPTH];    ///< Per level: the bracket that closes it
+    size_t          len_;                   ///< Bytes in buf_
+    char            buf_[BUF_SIZE];         ///< Output buffer
+
+    void init()
+    {
+        depth_       = 0;
+        isKeyed_     = false;
+        hasItems_[0] = false;
+        closers_[0]  = '\0';
+        len_         = 0;
+    }
+
+    void flush()
+    {
+        const char *p = buf_;
+
+        if(str_)
+        {
+            str_->append(buf_, len_);
+        }
+        else while(p < buf_ + len_)
+        {
+            ssize_t n = write(fd_, p, buf_ + len_ - p);
+
+            if(n < 0)
+            {
+                if(EINTR == errno)
+                {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "Cannot write " + tmpPath_);
+            }
+            p += n;
+        }
+        len_ = 0;
+    }
+
+    void reserve(size_t n)
+    {
+        if(len_ + n > BUF_SIZE)
+        {
+            flush();
+        }
+    }
+
+    void put(char c)
+    {
+        reserve(1);
+        buf_[len_++] = c;
+    }
+
+    JsonWriter& putRaw(const char *text, size_t n)
+    {
+        if(n > BUF_SIZE)
+        {
+            flush();
+            if(str_)                        str_->append(text, n);
+            else for(size_t i = 0; i < n; ++i) put(text[i]);
+            return *this;
+        }
+        reserve(n);
+        memcpy(buf_ + len_, text, n);
+        len_ += n;
+        return *this;
+    }
+
+    void putString(const char *text, size_t n)
+    {
+        static const char HEX[] = "0123456789abcdef";
+        const char       *run   = text;                 // Start of the current run of plain chars
+
+        put('"');
+        for(const char *p = text; p < text + n; ++p)
+        {
+            u_char c = *p;
+
+            if((c >= 0x20) && (c != '"') && (c != '\\'))
+            {
+                continue;
+            }
+            putRaw(run, p - run);
+            run = p + 1;
+            switch(c)
+            {
+                case '"':   putRaw("\\\"", 2);  break;
+                case '\\':  putRaw("\\\\", 2);  break;
+                case '\n':  putRaw("\\n",  2);  break;
+                case '\r':  putRaw("\\r",  2);  break;
+                case '\t':  putRaw("\\t",  2);  break;
+                default:
+                {
+                    char esc[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF] };
+
+                    putRaw(esc, sizeof(esc));
+                }
+            }
+        }
+        putRaw(run, text + n - run);
+        put('"');
+    }
+
+    /*
+     * Puts a comma before the next item if it needs one.  Values (including
+     * nested objects and arrays) in an object must follow their key.
+     */
+    void separate()
+    {
+        if(isKeyed_)
+        {
+            isKeyed_ = false;
+        }
+        else
+        {
+            if(!depth_ && hasItems_[0])
+            {
+                throw std::logic_error("JSON document already has its top-level value");
+            }
+            if('}' == closers_[depth_])
+            {
+                throw std::logic_error("JSON object member without a key");
+            }
+            if(hasItems_[depth_])
+            {
+                put(',');
+            }
+            hasItems_[depth_] = true;
+        }
+    }
+
+    JsonWriter& openLevel(char bracket)
+    {
+        separate();
+        if(depth_ + 1 >= MAX_DEPTH)
+        {
+            throw std::length_error("JSON nested too deeply");
+        }
+        put(bracket);
+        ++depth_;
+        hasItems_[depth_] = false;
+        closers_[depth_]  = ('{' == bracket) ? '}' : ']';
+        return *this;
+    }
+
+    JsonWriter& closeLevel(char bracket)
+    {
+        if(!depth_ || (bracket != closers_[depth_]) || isKeyed_)
+        {
+            throw std::logic_error(isKeyed_ ? "JSON key without a value"
+                                            : "Unbalanced JSON document");
+        }
+        --depth_;
+        put(bracket);
+        return *this;
+    }
+};
+
+
+} } // ns{ oi::util }
+
+#endif	/* JSONWRITER_HPP */
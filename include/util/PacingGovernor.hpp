@@ -0,0 +1,226 @@
+/*\***********************************************************************\*//**
+ * MODULE: PacingGovernor.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef PACINGGOVERNOR_HPP
+#define	PACINGGOVERNOR_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glob.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#include "util/Logger.hpp"
+
+namespace oi { namespace util {
+
+
+// --------------------------------------------------------------------------
+// PacingGovernor:
+// --------------------------------------------------------------------------
+/**
+ * Decides whether the node needs a break before the next job, based on what
+ * the machine is actually doing rather than on fixed naps:
+ *
+ *  - the 1-minute load average per online CPU (/proc/loadavg), less the
+ *    load Sibyl puts on the node herself
+ *  - the hottest thermal zone (/sys/class/thermal/thermal_zone*\/temp)
+ *  - how far the cores have been clocked down from their maximum frequency
+ *    (/sys/devices/system/cpu/cpu*\/cpufreq), which only counts as
+ *    throttling while the machine is busy
+ *
+ * A cool node that nobody else is loading runs its jobs back to back.  A
+ * hot node, or one that other work is loading, waits in short steps until it
+ * recovers, up to a maximum wait.  Sensors that a machine does not have are
+ * simply ignored.
+ *
+ * Our own load has to come off the load average.  An MPI node runs a rank
+ * per core, and a loner node runs several workers, each with its fitness
+ * threads, so Sibyl alone keeps the load near one per CPU.  Counting that
+ * would make nearly every job sit out the maximum wait.
+ */
+// --------------------------------------------------------------------------
+class PacingGovernor
+{
+public:
+    /**
+     * A snapshot of the node's state
+     */
+    struct Reading
+    {
+        double  loadPerCPU_;        ///< 1-minute load average / online CPUs (ours included)
+        double  maxTempC_;          ///< Hottest thermal zone, or 0 if unknown
+        double  freqRatio_;         ///< Mean current/max CPU frequency, or 1 if unknown
+    };
+
+
+    /**
+     * Creates a governor
+     *
+     * @param maxLoad       Highest acceptable load average per CPU, not
+     *                      counting our own
+     * @param maxTempC      Highest acceptable temperature (Celsius)
+     * @param ownLoad       Runnable threads Sibyl keeps busy on this node
+     *                      (jobs on the node times threads per job)
+     * @param minFreqRatio  Lowest acceptable current/max frequency under load
+     * @param stepSecs      Seconds between checks while waiting
+     * @param maxWaitSecs   Longest we wait before running anyway
+     *///--------------------------------------------------------------------
+    PacingGovernor(double maxLoad      = 1.0,
+                   double maxTempC     = 80.0,
+                   double ownLoad      = 0.0,
+                   double minFreqRatio = 0.8,
+                   u_int  stepSecs     = 15,
+                   u_int  maxWaitSecs  = 10 * 60)
+    : maxLoad_     (maxLoad),
+      maxTempC_    (maxTempC),
+      minFreqRatio_(minFreqRatio),
+      stepSecs_    (stepSecs),
+      maxWaitSecs_ (maxWaitSecs),
+      numCPUs_     (std::max(1L, sysconf(_SC_NPROCESSORS_ONLN))),
+      ownPerCPU_   (std::min(ownLoad, (double) numCPUs_) / numCPUs_)
+    { }
+
+
+    /**
+     * Reads the node's current state
+     *///--------------------------------------------------------------------
+    Reading read() const
+    {
+        Reading       now   = { 0.0, 0.0, 1.0 };
+        std::ifstream loads("/proc/loadavg");
+        double        load1 = 0.0;
+
+        if(loads >> load1)
+        {
+            now.loadPerCPU_ = load1 / numCPUs_;
+        }
+
+        for(auto& path : glob("/sys/class/thermal/thermal_zone*/temp"))
+        {
+            now.maxTempC_ = std::max(now.maxTempC_, readNumber(path) / 1000.0);
+        }
+
+        double sum = 0.0;
+        int    cnt = 0;
+
+        for(auto& dir : glob("/sys/devices/system/cpu/cpu[0-9]*/cpufreq"))
+        {
+            double cur = readNumber(dir + "/scaling_cur_freq");
+            double max = readNumber(dir + "/cpuinfo_max_freq");
+
+            if((cur > 0.0) && (max > 0.0))
+            {
+                sum += cur / max;
+                ++cnt;
+            }
+        }
+        if(cnt)
+        {
+            now.freqRatio_ = sum / cnt;
+        }
+        return now;
+    }
+
+
+    /**
+     * Returns the reason the node needs a break, or an empty string if it
+     * may go ahead
+     *///--------------------------------------------------------------------
+    std::string check(const Reading& now) const
+    {
+        std::ostringstream why;
+
+        if(now.maxTempC_ > maxTempC_)
+        {
+            why << "temp " << now.maxTempC_ << "C";
+        }
+        else if(now.loadPerCPU_ - ownPerCPU_ > maxLoad_)
+        {
+            why << "load " << now.loadPerCPU_ << "/cpu (" << ownPerCPU_ << " ours)";
+        }
+        else if((now.loadPerCPU_ > maxLoad_ / 2) && (now.freqRatio_ < minFreqRatio_))
+        {
+            why << "throttled to " << (int) (100 * now.freqRatio_) << "% clock";
+        }
+        return why.str();
+    }
+
+
+    /**
+     * Waits until the node is fit for the next job or the wait limit is up
+     *
+     * @param out       Output stream for logging
+     *
+     * @return          Seconds spent waiting
+     *///--------------------------------------------------------------------
+    u_int pace(std::ostream& out) const
+    {
+        u_int waited = 0;
+
+        for(std::string why = check(read());
+            !why.empty();
+            why = check(read()))
+        {
+            if(waited >= maxWaitSecs_)
+            {
+                out << LOG_INFO << "Pacing: still " << why << " after " << waited << "s; running anyway" << std::endl;
+                break;
+            }
+            if(!waited)
+            {
+                out << LOG_INFO << "Pacing: " << why << "; cooling down" << std::endl;
+            }
+            sleep(stepSecs_);
+            waited += stepSecs_;
+        }
+        return waited;
+    }
+
+
+private:
+    double  maxLoad_;               ///< Highest load average per CPU
+    double  maxTempC_;              ///< Highest temperature
+    double  minFreqRatio_;          ///< Lowest current/max frequency under load
+    u_int   stepSecs_;              ///< Check interval while waiting
+    u_int   maxWaitSecs_;           ///< Wait limit per pace() call
+    long    numCPUs_;               ///< Online CPUs
+    double  ownPerCPU_;             ///< Our own share of the load average per CPU
+
+    static std::vector<std::string> glob(const std::string& pattern)
+    {
+        std::vector<std::string> paths;
+        glob_t                   found = { };
+
+        if(0 == ::glob(pattern.c_str(), 0, NULL, &found))
+        {
+            paths.assign(found.gl_pathv, found.gl_pathv + found.gl_pathc);
+        }
+        globfree(&found);
+        return paths;
+    }
+
+    static double readNumber(const std::string& path)
+    {
+        std::ifstream in(path.c_str());
+        double        val = 0.0;
+
+        in >> val;
+        return val;
+    }
+};
+
+
+} } // ns{ oi::util }
+
+#endif	/* PACINGGOVERNOR_HPP */
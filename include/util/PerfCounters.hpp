@@ -0,0 +1,205 @@
+/*\***********************************************************************\*//**
+ * MODULE: PerfCounters.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+#ifndef PERFCOUNTERS_HPP
+#define	PERFCOUNTERS_HPP
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+
+#if HAVE_LINUX_PERF_EVENT_H
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+namespace oi { namespace util {
+
+
+// --------------------------------------------------------------------------
+// PerfCounters:
+// --------------------------------------------------------------------------
+/**
+ * Hardware performance counters for the calling thread, through Linux
+ * perf_event_open: cycles, instructions, last-level cache misses and branch
+ * misses.  This tells us whether evaluation is stalling on memory or on
+ * mispredicted branches, on the production boxes, without an external
+ * profiler.
+ *
+ * Counters are per thread (see forThisThread()), so a thread's readings
+ * only cover its own work.  When the kernel multiplexes the PMU, readings
+ * are scaled by enabled/running time.  Where perf events are not available
+ * (no kernel support, perf_event_paranoid too strict, not Linux), isOpen()
+ * is false and every reading is zero.
+ */
+// --------------------------------------------------------------------------
+class PerfCounters
+{
+public:
+    enum Event
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_EVENTS
+    };
+
+
+    /**
+     * Counter values at a point in time, or over an interval
+     */
+    struct Sample
+    {
+        uint64_t    counts_[NUM_EVENTS];        ///< Indexed by Event
+
+        Sample& operator+=(const Sample& rhs)
+        {
+            for(int e = 0; e < NUM_EVENTS; ++e) counts_[e] += rhs.counts_[e];
+            return *this;
+        }
+
+        Sample& operator-=(const Sample& rhs)
+        {
+            for(int e = 0; e < NUM_EVENTS; ++e) counts_[e] -= rhs.counts_[e];
+            return *this;
+        }
+
+        /**
+         * Returns instructions per cycle
+         */
+        double getIPC() const
+        {
+            return counts_[CYCLES] ? ((double) counts_[INSTRUCTIONS] / counts_[CYCLES]) : 0.0;
+        }
+    };
+
+
+    /**
+     * Opens the counters for the calling thread.  They start counting
+     * right away.
+     *///--------------------------------------------------------------------
+    PerfCounters()
+    {
+        for(int e = 0; e < NUM_EVENTS; ++e)
+        {
+            fds_[e] = openEvent((Event) e);
+        }
+    }
+
+
+    /**
+     * Closes the counters
+     *///--------------------------------------------------------------------
+    ~PerfCounters()
+    {
+        for(int fd : fds_)
+        {
+            if(fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+
+    PerfCounters(const PerfCounters& that) = delete;                ///< DISABLED!
+    PerfCounters & operator=(const PerfCounters& rhs) = delete;     ///< DISABLED!
+
+
+    /**
+     * Returns the calling thread's counters, opening them on first use
+     *///--------------------------------------------------------------------
+    static PerfCounters& forThisThread()
+    {
+        static thread_local PerfCounters mine;
+
+        return mine;
+    }
+
+
+    /**
+     * Returns the name of an event, for logs and JSON
+     *///--------------------------------------------------------------------
+    static const char* getEventName(Event event)
+    {
+        static const char *NAMES[NUM_EVENTS] = { "cycles", "instructions", "llc_misses", "branch_misses" };
+
+        return NAMES[event];
+    }
+
+
+    /**
+     * Returns true if the cycle counter (at least) is working
+     *///--------------------------------------------------------------------
+    bool isOpen() const
+    {
+        return fds_[CYCLES] >= 0;
+    }
+
+
+    /**
+     * Reads the counters.  Subtract two readings to get the counts for the
+     * work in between.
+     *///--------------------------------------------------------------------
+    Sample read() const
+    {
+        Sample now = { };
+
+        for(int e = 0; e < NUM_EVENTS; ++e)
+        {
+            uint64_t vals[3];       // value, time enabled, time running
+
+            if((fds_[e] >= 0) && (::read(fds_[e], vals, sizeof(vals)) == (ssize_t) sizeof(vals)))
+            {
+                now.counts_[e] = (vals[2] && (vals[2] < vals[1]))
+                               ? (uint64_t) ((double) vals[0] * vals[1] / vals[2])
+                               : vals[0];
+            }
+        }
+        return now;
+    }
+
+
+private:
+    int     fds_[NUM_EVENTS];       ///< Counter file descriptors (-1 if unavailable)
+
+    static int openEvent(Event event)
+    {
+#if HAVE_LINUX_PERF_EVENT_H
+        static const uint64_t CONFIGS[NUM_EVENTS] = { PERF_COUNT_HW_CPU_CYCLES,
+                                                      PERF_COUNT_HW_INSTRUCTIONS,
+                                                      PERF_COUNT_HW_CACHE_MISSES,
+                                                      PERF_COUNT_HW_BRANCH_MISSES };
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.config         = CONFIGS[event];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // This thread, any CPU
+        return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+        return -1;
+#endif
+    }
+};
+
+
+} } // ns{ oi::util }
+
+#endif	/* PERFCOUNTERS_HPP */
@@ -0,0 +1,546 @@
+/************************************************************************//**
+ * MODULE: bench.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//************************************************************************/
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include "sibyl.hpp"
+#include "oi-cluster.hpp"
+#include "genprog/Chromocode.hpp"
+#include "genprog/ColumnWindow.hpp"
+#include "genprog/GeneTree.hpp"
+#include "genprog/Individual.hpp"
+#include "genprog/OpKernels.hpp"
+#include "market/AttrDeriver.hpp"
+#include "market/DelphiFile.hpp"
+#include "market/PriceDataPack.hpp"
+#include "market/PriceWorld.hpp"
+#include "market/Prognosticator.hpp"
+#include "util/HardwareProbe.hpp"
+#include "util/JsonWriter.hpp"
+
+namespace po = boost::program_options;
+
+using namespace std;
+using namespace oi;
+using namespace oi::genprog;
+using namespace oi::market;
+using namespace oi::util;
+
+
+// --------------------------------------------------------------------------
+// Project Global Data:
+// --------------------------------------------------------------------------
+namespace oi {
+
+const string OK_("!OK!");
+const string ERROR_("!ERR!");
+
+string CFG_DB_HOST("localhost");                ///< Unused: we bench on synthetic data
+string CFG_DB_USER("pythia");                   ///< Unused: we bench on synthetic data
+
+} // ns{ oi }
+
+
+// --------------------------------------------------------------------------
+// Module Global Data:
+// --------------------------------------------------------------------------
+static const char  *SYMBOL      = "BENCH";      ///< Synthetic security
+static const int    NUM_DAYS    = 2000;         ///< Synthetic price history
+static const int    DAYS_IN_WIN = 90;           ///< GP window for the synthetic world
+static const size_t POOL_SIZE   = 256;          ///< Individuals prepared per benchmark
+static const int    NUM_REPEATS = 5;            ///< Timed runs per benchmark
+static const u_int  BLOCK_DAYS  = 1024;         ///< Days per GP kernel call
+
+static volatile Real Sink;                      ///< Keeps the optimizer honest
+
+
+/**
+ * Timing for one benchmark
+ */
+struct BenchResult
+{
+    string  name_;              ///< Benchmark name: group.operation[.param]
+    u_long  iterations_;        ///< Operations per timed run
+    double  medianNs_;          ///< Median ns/op over the timed runs
+    double  minNs_;             ///< Fastest ns/op
+    double  maxNs_;             ///< Slowest ns/op
+};
+
+
+// --------------------------------------------------------------------------
+// bench:
+// --------------------------------------------------------------------------
+/**
+ * Times an operation: a short warm-up, then NUM_REPEATS timed runs.
+ *
+ * @param name          Benchmark name
+ * @param iterations    Operations per timed run
+ * @param op            The operation, called with the iteration number
+ *
+ * @return              The timing results
+ */
+// --------------------------------------------------------------------------
+static BenchResult bench(const string&             name,
+                         u_long                    iterations,
+                         function<void(u_long)>    op)
+{
+    using Clock = chrono::steady_clock;
+
+    vector<double> nsPerOp;
+
+    for(u_long i = 0; i < max(1UL, iterations / 10); ++i)
+    {
+        op(i);
+    }
+
+    for(int r = 0; r < NUM_REPEATS; ++r)
+    {
+        auto start = Clock::now();
+
+        for(u_long i = 0; i < iterations; ++i)
+        {
+            op(i);
+        }
+        nsPerOp.push_back(chrono::duration<double, nano>(Clock::now() - start).count() / iterations);
+    }
+
+    sort(nsPerOp.begin(), nsPerOp.end());
+    cerr << name << ": " << nsPerOp[NUM_REPEATS / 2] << " ns/op" << endl;
+
+    return BenchResult { name, iterations, nsPerOp[NUM_REPEATS / 2], nsPerOp.front(), nsPerOp.back() };
+}
+
+
+// --------------------------------------------------------------------------
+// makeDelphiDir:
+// --------------------------------------------------------------------------
+/**
+ * Writes a random-walk price history for the synthetic security where
+ * DelphiFile can find it.
+ *
+ * @return  The directory for DelphiFile
+ */
+// --------------------------------------------------------------------------
+static string makeDelphiDir()
+{
+    char dirTmpl[] = "/tmp/sibyl-bench.XXXXXX";
+
+    if(!mkdtemp(dirTmpl))
+    {
+        throw runtime_error("Cannot create bench data directory");
+    }
+
+    string   dir(dirTmpl);
+    ofstream secs(dir + "/securities.csv");
+
+    secs << SYMBOL << ",2026-10-16" << endl;
+    mkdir((dir + "/prices").c_str(), 0775);
+
+    ofstream prices(dir + "/prices/" + SYMBOL + ".csv");
+    Real     close = 100.0;
+
+    prices << "open,high,low,close,volume" << endl;
+    for(int d = 0; d < NUM_DAYS; ++d)
+    {
+        Real open = close * (1.0 + 0.01 * (drand48() - 0.5));
+
+        close = open * (1.0 + 0.02 * (drand48() - 0.5));
+        prices << open                              << ','
+               << (max(open, close) * 1.005)        << ','
+               << (min(open, close) * 0.995)        << ','
+               << close                             << ','
+               << (1000000 + lrand48() % 500000)    << endl;
+    }
+    return dir;
+}
+
+
+// --------------------------------------------------------------------------
+// benchGP:
+// --------------------------------------------------------------------------
+/**
+ * Benchmarks the GP primitives against a world on synthetic data
+ */
+// --------------------------------------------------------------------------
+static void benchGP(const World& world, u_long iterations, vector<BenchResult>& results)
+{
+    Individual_Vp pool;
+    Individual_Vp crib(2);
+
+    for(size_t i = 0; i < POOL_SIZE; ++i)
+    {
+        pool.push_back(make_unique<Individual>(world));
+    }
+
+    results.push_back(bench("allele.newRandAllele", iterations, [&](u_long)
+                            {
+                                delete Allele::newRandAllele(world);
+                            }));
+
+    results.push_back(bench("individual.create", iterations, [&](u_long)
+                            {
+                                Individual guy(world);
+                                Sink = guy.getChromoNodeCnt();
+                            }));
+
+    results.push_back(bench("individual.copy", iterations, [&](u_long i)
+                            {
+                                Individual guy(*pool[i % POOL_SIZE]);
+                                Sink = guy.getChromoNodeCnt();
+                            }));
+
+    results.push_back(bench("individual.crossover", iterations, [&](u_long i)
+                            {
+                                pool[i % POOL_SIZE]->mate(pool[(i + 1) % POOL_SIZE], crib, 0, 1);
+                            }));
+
+    results.push_back(bench("individual.toString", iterations, [&](u_long i)
+                            {
+                                Sink = pool[i % POOL_SIZE]->toString().size();
+                            }));
+
+    results.push_back(bench("individual.parse", iterations, [&](u_long i)
+                            {
+                                Individual guy(world, pool[i % POOL_SIZE]->toString());
+                                Sink = guy.getChromoNodeCnt();
+                            }));
+
+    // Only chromosomes whose every allele encodes can be benched as codes
+    // and as tagged nodes over synthetic columns, with a window deep enough
+    // for every lookup
+    vector<GeneTree> trees;
+    u_int            winLen = 1;
+
+    try
+    {
+        for(auto& guy : pool)
+        {
+            trees.emplace_back(guy->encode());
+            winLen = max(winLen, trees.back().getMaxLag() + 1);
+        }
+    }
+    catch(logic_error& e)
+    {
+        cerr << "Skipping chromocode benchmarks: " << e.what() << endl;
+        trees.clear();
+    }
+
+    if(!trees.empty())
+    {
+        results.push_back(bench("chromocode.encode", iterations, [&](u_long i)
+                                {
+                                    Sink = pool[i % POOL_SIZE]->encode().pack().size();
+                                }));
+
+        vector<vector<Real>> cols(5, vector<Real>(NUM_DAYS));
+        vector<const Real*>  base;
+        vector<Real>         scratch;
+
+        for(auto& col : cols)
+        {
+            for(auto& x : col)
+            {
+                x = 100.0 + 10.0 * drand48();
+            }
+            base.push_back(col.data());
+        }
+        ColumnWindow win(base, NUM_DAYS, winLen, 3);
+
+        results.push_back(bench("genetree.decode", iterations, [&](u_long i)
+                                {
+                                    GeneTree tree(pool[i % POOL_SIZE]->encode());
+                                    Sink = tree.getNodeCnt();
+                                }));
+
+        results.push_back(bench("genetree.copy", iterations, [&](u_long i)
+                                {
+                                    GeneTree tree(trees[i % POOL_SIZE]);
+                                    Sink = tree.getNodeCnt();
+                                }));
+
+        results.push_back(bench("genetree.value", iterations, [&](u_long i)
+                                {
+                                    win.setCursor(i % win.getNumDays());
+                                    Sink = trees[i % POOL_SIZE].getValue(win);
+                                }));
+
+        results.push_back(bench("genetree.block", max(1UL, iterations / 100), [&](u_long i)
+                                {
+                                    u_int numDays = min(BLOCK_DAYS, win.getNumDays());
+
+                                    Sink = trees[i % POOL_SIZE].evalBlock(win, 0, numDays, scratch)[0];
+                                }));
+    }
+
+    // Mutation changes the pool, so it goes last
+    results.push_back(bench("individual.mutate", iterations, [&](u_long i)
+                            {
+                                pool[i % POOL_SIZE]->mutate();
+                            }));
+}
+
+
+// --------------------------------------------------------------------------
+// benchData:
+// --------------------------------------------------------------------------
+/**
+ * Benchmarks the price data paths: indicator derivation and strided window
+ * lookups for windows of several sizes
+ */
+// --------------------------------------------------------------------------
+static void benchData(u_long iterations, vector<BenchResult>& results)
+{
+    vector<vector<Real>> cols(5, vector<Real>(NUM_DAYS));
+    vector<string>       names = { "open", "high", "low", "close", "volume" };
+    vector<const Real*>  base;
+
+    for(auto& col : cols)
+    {
+        for(auto& x : col)
+        {
+            x = 100.0 + 10.0 * drand48();
+        }
+        base.push_back(col.data());
+    }
+
+    AttrDeriver deriver;
+    deriver.addSpec("close:50,200; ema:close:12,26; std:close:20; rsi:close:14; ret:close:1,5", names);
+
+    results.push_back(bench("attrs.derive", max(1UL, iterations / 1000), [&](u_long)
+                            {
+                                deriver.derive(base, NUM_DAYS);
+                                Sink = deriver.column(0).back();
+                            }));
+
+    for(u_int winLen : { 10, 30, 90 })
+    {
+        ColumnWindow win(base, NUM_DAYS, winLen, 3);
+        u_int        numDays = win.getNumDays();
+
+        results.push_back(bench("window.stream." + to_string(winLen), max(1UL, iterations / 100), [&](u_long i)
+                                {
+                                    const Real *x   = win.stream(i % 5, i % winLen);
+                                    Real        sum = 0.0;
+
+                                    for(u_int d = 0; d < numDays; ++d)
+                                    {
+                                        sum += x[d];
+                                    }
+                                    Sink = sum;
+                                }));
+    }
+}
+
+
+// --------------------------------------------------------------------------
+// benchKernels:
+// --------------------------------------------------------------------------
+/**
+ * Benchmarks a block of days through the batched GP function kernels at
+ * each SIMD level the CPU supports
+ */
+// --------------------------------------------------------------------------
+static void benchKernels(u_long iterations, vector<BenchResult>& results)
+{
+    vector<Real> x(BLOCK_DAYS);
+    vector<Real> y(BLOCK_DAYS);
+    vector<Real> out(BLOCK_DAYS);
+
+    for(u_int d = 0; d < BLOCK_DAYS; ++d)
+    {
+        x[d] = 10.0 * (drand48() - 0.5);
+        y[d] = 10.0 * (drand48() - 0.5);
+    }
+
+    for(int level = HardwareProbe::SIMD_NONE; level <= HardwareProbe::getSIMD(); ++level)
+    {
+        auto simd = (HardwareProbe::SIMD) level;
+
+        if(OpKernels::select(simd) != simd)
+        {
+            continue;               // No kernel set of its own at this level
+        }
+
+        for(auto func : { "ADD", "MUL", "DIV", "SQRT", "POW", "SIN", "LOG", "EXP" })
+        {
+            auto kernel = OpKernels::get(Chromocode::opcodeOf(func));
+
+            results.push_back(bench(string("kernel.") + func + "." + HardwareProbe::getSIMDName(simd),
+                                    max(1UL, iterations / 10), [&](u_long)
+                                    {
+                                        kernel(out.data(), x.data(), y.data(), BLOCK_DAYS);
+                                        Sink = out[0];
+                                    }));
+        }
+    }
+    OpKernels::select(HardwareProbe::getSIMD());
+}
+
+
+// --------------------------------------------------------------------------
+// writeJSON:
+// --------------------------------------------------------------------------
+/**
+ * Writes the results for regression tracking
+ */
+// --------------------------------------------------------------------------
+static void writeJSON(JsonWriter&                json,
+                      const string&              seeds,
+                      const vector<BenchResult>& results)
+{
+    char host[64];
+
+    gethostname(host, sizeof(host));
+    host[sizeof(host)-1] = '\0';
+
+    json.beginObject()
+            .field("program", "sibyl-bench")
+            .field("version", PACKAGE_VERSION)
+            .field("host",    host)
+            .field("seeds48", seeds)
+            .field("real",    (int) sizeof(Real))
+            .key("benchmarks").beginArray();
+
+    for(auto& res : results)
+    {
+        json.beginObject()
+                .field("name",       res.name_)
+                .field("iterations", (int64_t) res.iterations_)
+                .field("median_ns",  res.medianNs_)
+                .field("min_ns",     res.minNs_)
+                .field("max_ns",     res.maxNs_)
+            .endObject();
+    }
+    json.endArray()
+        .endObject()
+        .commit();
+}
+
+
+// --------------------------------------------------------------------------
+// main:
+// --------------------------------------------------------------------------
+/**
+ * Microbenchmarks for the GP core.  Everything runs on synthetic data with
+ * fixed rand48 seeds, so runs on the same build are comparable.  Progress
+ * goes to stderr; the results go to stdout (or --json) as JSON.
+ *
+ * @param argc  Count of command line parameters
+ * @param argv  Array of command line parameters
+ *
+ * @return      Final return code for the program
+ */
+// --------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    int rc = EXIT_SUCCESS;
+
+    try
+    {
+        MPI_Environment  mpiEnv(argc, argv);
+        MPI_Communicator mpiWorld;
+
+        po::variables_map       cfg;
+        po::options_description descr("sibyl-bench options");
+
+        descr.add_options()
+                ("help,?",                                                              "Display this help text")
+                ("iterations,n", po::value<u_long>()->default_value(20000),            "Operations per timed run")
+                ("json",         po::value<string>(),                                   "Write results to this file")
+                ("seeds48",      po::value<string>()->default_value("1,2,3"),           "Seed array for rand48 RNG")
+                ("verbose,v",                                                           "Show Sibyl's logging on stderr");
+
+        po::store(po::parse_command_line(argc, argv, descr), cfg);
+        po::notify(cfg);
+
+        if(cfg.count("help"))
+        {
+            cout << descr << endl;
+            return EXIT_SUCCESS;
+        }
+
+        // Fixed seeds for repeatable data and trees
+        string         seedText = cfg["seeds48"].as<string>();
+        vector<string> seedList;
+        unsigned short seeds[3] = { 1, 2, 3 };
+
+        boost::split(seedList, seedText, boost::is_any_of(", "), boost::token_compress_on);
+        for(size_t i = 0; (i < seedList.size()) && (i < 3); ++i)
+        {
+            seeds[i] = stoi(seedList[i]);
+        }
+        seed48(seeds);
+        srandom(seeds[0]);
+
+        // A world to breed in...
+        ofstream       devNull("/dev/null");
+        ostream&       log       = cfg.count("verbose") ? cerr : devNull;
+        string         delphiDir = makeDelphiDir();
+        DelphiFile     db(delphiDir);
+        PriceDataPack  priceData(log);
+        vector<ProgJob> jobs;
+
+        ProgJob::fill("close:5", jobs, true);
+        priceData.loadAndShare(mpiWorld, db, SYMBOL, NUM_DAYS);
+
+        PriceWorld world(string(SYMBOL) + ".close.5", "2026-10-16", log);
+        world.configureJob(jobs[0], priceData, DAYS_IN_WIN);
+
+        // Go!
+        u_long              iterations = cfg["iterations"].as<u_long>();
+        vector<BenchResult> results;
+
+        benchGP(world, iterations, results);
+        benchData(iterations, results);
+        benchKernels(iterations, results);
+
+        if(cfg.count("json"))
+        {
+            JsonWriter json(cfg["json"].as<string>());
+            writeJSON(json, seedText, results);
+        }
+        else
+        {
+            string     text;
+            JsonWriter json(text);
+
+            writeJSON(json, seedText, results);
+            cout << text;
+        }
+
+        unlink((delphiDir + "/prices/" + SYMBOL + ".csv").c_str());
+        unlink((delphiDir + "/securities.csv").c_str());
+        rmdir((delphiDir + "/prices").c_str());
+        rmdir(delphiDir.c_str());
+    }
+    catch(exception& e)
+    {
+        cerr << e.what() << endl;
+        rc = EXIT_FAILURE;
+    }
+
+    return rc;
+}
@@ -15,6 +15,7 @@
 #include "genprog/ConstAllele.hpp"
 #include "genprog/FuncAllele.hpp"
 #include "genprog/LookupAllele.hpp"
+#include "genprog/MemStats.hpp"
 
 namespace oi { namespace genprog {
 
@@ -45,7 +46,9 @@ const FactoryPtr Allele::FactoryLib[] = { ConstAllele::newAllele,
 Allele::Allele(Allele *parent) :    nodeCnt_ (1     ),
                                     parent_  (parent)
 
-{ }
+{
+    MemStats::created(MemStats::ALLELE);
+}
 
 
 // --------------------------------------------------------------------------
@@ -61,7 +64,9 @@ Allele::Allele(Allele *parent) :    nodeCnt_ (1     ),
 // --------------------------------------------------------------------------
 Allele::Allele(const Allele& that) :    nodeCnt_ (1   ),    // Recalculated in subclass
                                         parent_  (NULL)
-{ }
+{
+    MemStats::created(MemStats::ALLELE);
+}
 
 
 // --------------------------------------------------------------------------
@@ -76,6 +81,8 @@ Allele::~Allele()
     // Don't delete the node pointer because we don't own it,
     // but NULL it out in case we try to access it after deletion
     parent_ = NULL;
+
+    MemStats::destroyed(MemStats::ALLELE);
 }
 
 
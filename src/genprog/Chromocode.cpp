@@ -0,0 +1,447 @@
+/***************************************************************************/
+/**
+ * MODULE: Chromocode.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <cstring>
+#include <stdexcept>
+
+#include "genprog/Allele.hpp"
+#include "genprog/Chromocode.hpp"
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+
+/***************************************************************************/
+/* CONSTANTS                                                               */
+/***************************************************************************/
+static const char MAGIC_0 = 'G';                ///< Packed code signature
+static const char MAGIC_1 = 'C';
+
+/**
+ * Wire opcodes: the index into this table is the opcode.
+ *
+ * @warning APPEND ONLY!  Codes are stored in Delphi and checkpoints.
+ */
+static const Chromocode::OpInfo OpTable[] = { { "ADD",  2 },    //  0
+                                              { "SUB",  2 },    //  1
+                                              { "MUL",  2 },    //  2
+                                              { "DIV",  2 },    //  3   (protected)
+                                              { "INV",  1 },    //  4   (protected)
+                                              { "NEG",  1 },    //  5
+                                              { "ABS",  1 },    //  6
+                                              { "SQRT", 1 },    //  7   (protected)
+                                              { "CBRT", 1 },    //  8
+                                              { "POW",  2 },    //  9   (protected)
+                                              { "SIN",  1 },    // 10
+                                              { "COS",  1 },    // 11
+                                              { "TAN",  1 },    // 12
+                                              { "LOG",  1 },    // 13   (protected)
+                                              { "EXP",  1 },    // 14
+                                              { "MIN",  2 },    // 15
+                                              { "MAX",  2 },    // 16
+                                              { "SQR",  1 },    // 17
+                                              { "CUBE", 1 },    // 18
+                                              { "AVG",  2 }     // 19
+                                            };
+
+static const u_int NumOpcodes = sizeof(OpTable) / sizeof(OpTable[0]);
+
+static_assert(NumOpcodes == Chromocode::NUM_OPCODES, "Chromocode::Opcode is out of step with OpTable");
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// ---------------------------------------------------------------- STATIC --
+// opcodeOf:
+// --------------------------------------------------------------------------
+/**
+ * Returns the wire opcode for a GP function
+ *
+ * @param funcName  The function's name as it appears in toString()
+ *
+ * @return          The wire opcode, or NO_OPCODE for an unknown function
+ */
+// --------------------------------------------------------------------------
+u_char Chromocode::opcodeOf(const string& funcName)
+{
+    for(u_int op = 0; op < NumOpcodes; ++op)
+    {
+        if(funcName == OpTable[op].name_)
+        {
+            return op;
+        }
+    }
+    return NO_OPCODE;
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getOpInfo:
+// --------------------------------------------------------------------------
+/**
+ * Returns the name and arity for a wire opcode
+ *
+ * @param opcode    A wire opcode
+ *
+ * @return          Information about the GP function
+ */
+// --------------------------------------------------------------------------
+const Chromocode::OpInfo& Chromocode::getOpInfo(u_char opcode)
+{
+    if(opcode >= NumOpcodes)
+    {
+        throw out_of_range("Unknown chromocode opcode " + to_string(opcode));
+    }
+    return OpTable[opcode];
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getNumOpcodes:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of wire opcodes in this version of the format
+ */
+// --------------------------------------------------------------------------
+u_int Chromocode::getNumOpcodes()
+{
+    return NumOpcodes;
+}
+
+
+// --------------------------------------------------------------------------
+// putConst:
+// --------------------------------------------------------------------------
+/**
+ * Appends a ConstAllele to the code
+ *
+ * @param value     The constant's value
+ */
+// --------------------------------------------------------------------------
+void Chromocode::putConst(Real value)
+{
+    ops_.push_back(Allele::Const);
+    consts_.push_back(value);
+    ++numNodes_;
+}
+
+
+// --------------------------------------------------------------------------
+// putFunc:
+// --------------------------------------------------------------------------
+/**
+ * Appends a FuncAllele to the code.  The function's arguments follow as
+ * the next getOpInfo(opcode).arity_ subtrees.
+ *
+ * @param opcode    The function's wire opcode
+ */
+// --------------------------------------------------------------------------
+void Chromocode::putFunc(u_char opcode)
+{
+    if(opcode >= NumOpcodes)
+    {
+        throw invalid_argument("Cannot encode opcode " + to_string(opcode));
+    }
+    ops_.push_back(Allele::Func);
+    ops_.push_back(opcode);
+    ++numNodes_;
+}
+
+
+// --------------------------------------------------------------------------
+// putLookup:
+// --------------------------------------------------------------------------
+/**
+ * Appends a LookupAllele to the code
+ *
+ * @param attrNdx   Attribute index (or Allele::TARGET)
+ * @param lag       Offset into the attribute window
+ */
+// --------------------------------------------------------------------------
+void Chromocode::putLookup(u_int attrNdx, u_int lag)
+{
+    ops_.push_back(Allele::Lookup);
+    putVarint(attrNdx);
+    putVarint(lag);
+    ++numNodes_;
+}
+
+
+// --------------------------------------------------------------------------
+// pack:
+// --------------------------------------------------------------------------
+/**
+ * Returns the versioned byte string for the code:
+ *
+ *      'G' 'C' VERSION sizeof(Real) | nodes | opsLen | ops... | nConsts | consts...
+ *
+ * Counts are varints.  Constants are stored raw, as the whole cluster
+ * shares the same (little-endian, IEEE) Real representation.
+ *
+ * @return  The packed code
+ */
+// --------------------------------------------------------------------------
+string Chromocode::pack() const
+{
+    Chromocode hdr;                 // Lets us reuse putVarint for the counts
+    string     bytes;
+
+    hdr.ops_.push_back(MAGIC_0);
+    hdr.ops_.push_back(MAGIC_1);
+    hdr.ops_.push_back(VERSION);
+    hdr.ops_.push_back(sizeof(Real));
+    hdr.putVarint(numNodes_);
+    hdr.putVarint(ops_.size());
+
+    bytes.reserve(hdr.ops_.size() + ops_.size() + 5 + (consts_.size() * sizeof(Real)));
+    bytes  = hdr.ops_;
+    bytes += ops_;
+
+    hdr.ops_.clear();
+    hdr.putVarint(consts_.size());
+    bytes += hdr.ops_;
+    bytes.append(reinterpret_cast<const char*>(consts_.data()), consts_.size() * sizeof(Real));
+
+    return bytes;
+}
+
+
+// --------------------------------------------------------------------------
+// hash:
+// --------------------------------------------------------------------------
+/**
+ * Returns a 64-bit FNV-1a hash of the code.  Structurally identical trees
+ * (same functions, lookups and constant bits) hash the same.
+ *
+ * @return  The hash
+ */
+// --------------------------------------------------------------------------
+uint64_t Chromocode::hash() const
+{
+    const uint64_t PRIME = 0x100000001B3ULL;
+    uint64_t       h     = 0xCBF29CE484222325ULL;
+
+    for(u_char byte : ops_)
+    {
+        h = (h ^ byte) * PRIME;
+    }
+
+    const u_char *raw = reinterpret_cast<const u_char*>(consts_.data());
+
+    for(size_t i = 0; i < consts_.size() * sizeof(Real); ++i)
+    {
+        h = (h ^ raw[i]) * PRIME;
+    }
+    return h;
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// unpack:
+// --------------------------------------------------------------------------
+/**
+ * Rebuilds a code from its packed byte string
+ *
+ * @param bytes     The output from pack()
+ *
+ * @return          The code
+ */
+// --------------------------------------------------------------------------
+Chromocode Chromocode::unpack(const string& bytes)
+{
+    Chromocode code;
+    Chromocode wrapper;             // Lets us reuse the Reader's getVarint
+    size_t     numConsts;
+
+    if((bytes.size() < 4) || (MAGIC_0 != bytes[0]) || (MAGIC_1 != bytes[1]))
+    {
+        throw invalid_argument("Not a chromocode");
+    }
+    if((VERSION != bytes[2]) || (sizeof(Real) != (u_char) bytes[3]))
+    {
+        throw invalid_argument("Unsupported chromocode version " + to_string((int) bytes[2]));
+    }
+
+    wrapper.ops_ = bytes.substr(4);
+    Reader rdr(wrapper);
+
+    code.numNodes_ = rdr.getVarint();
+    size_t opsLen  = rdr.getVarint();
+    if(rdr.opNdx_ + opsLen > wrapper.ops_.size())
+    {
+        throw invalid_argument("Truncated chromocode");
+    }
+    code.ops_   = wrapper.ops_.substr(rdr.opNdx_, opsLen);
+    rdr.opNdx_ += opsLen;
+
+    numConsts = rdr.getVarint();
+    if(rdr.opNdx_ + (numConsts * sizeof(Real)) != wrapper.ops_.size())
+    {
+        throw invalid_argument("Truncated chromocode");
+    }
+    code.consts_.resize(numConsts);
+    memcpy(code.consts_.data(), wrapper.ops_.data() + rdr.opNdx_, numConsts * sizeof(Real));
+
+    return code;
+}
+
+
+// --------------------------------------------------------------------------
+// Reader::peekTag:
+// --------------------------------------------------------------------------
+/**
+ * Returns the Allele::Type of the next node without consuming it
+ */
+// --------------------------------------------------------------------------
+int Chromocode::Reader::peekTag() const
+{
+    if(atEnd())
+    {
+        throw out_of_range("Read past end of chromocode");
+    }
+    return code_.ops_[opNdx_];
+}
+
+
+// --------------------------------------------------------------------------
+// Reader::getConst:
+// --------------------------------------------------------------------------
+/**
+ * Consumes a ConstAllele node
+ *
+ * @return  The constant's value
+ */
+// --------------------------------------------------------------------------
+Real Chromocode::Reader::getConst()
+{
+    takeTag(Allele::Const);
+    if(constNdx_ >= code_.consts_.size())
+    {
+        throw out_of_range("Chromocode constant stream exhausted");
+    }
+    return code_.consts_[constNdx_++];
+}
+
+
+// --------------------------------------------------------------------------
+// Reader::getFunc:
+// --------------------------------------------------------------------------
+/**
+ * Consumes a FuncAllele node.  The caller then reads its arguments.
+ *
+ * @return  The function's wire opcode
+ */
+// --------------------------------------------------------------------------
+u_char Chromocode::Reader::getFunc()
+{
+    takeTag(Allele::Func);
+    if(atEnd())
+    {
+        throw out_of_range("Truncated chromocode function");
+    }
+
+    u_char opcode = code_.ops_[opNdx_++];
+
+    getOpInfo(opcode);              // Validate
+    return opcode;
+}
+
+
+// --------------------------------------------------------------------------
+// Reader::getLookup:
+// --------------------------------------------------------------------------
+/**
+ * Consumes a LookupAllele node
+ *
+ * @param attrNdx   Output: attribute index (or Allele::TARGET)
+ * @param lag       Output: offset into the attribute window
+ */
+// --------------------------------------------------------------------------
+void Chromocode::Reader::getLookup(u_int& attrNdx, u_int& lag)
+{
+    takeTag(Allele::Lookup);
+    attrNdx = getVarint();
+    lag     = getVarint();
+}
+
+
+/***************************************************************************/
+/* PRIVATE CLASS METHODS                                                   */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// putVarint:
+// --------------------------------------------------------------------------
+/**
+ * Appends an unsigned LEB128 integer to the opcode stream
+ */
+// --------------------------------------------------------------------------
+void Chromocode::putVarint(u_int n)
+{
+    while(n >= 0x80)
+    {
+        ops_.push_back((n & 0x7F) | 0x80);
+        n >>= 7;
+    }
+    ops_.push_back(n);
+}
+
+
+// --------------------------------------------------------------------------
+// Reader::takeTag:
+// --------------------------------------------------------------------------
+/**
+ * Consumes the next tag, which must be the one the caller expects
+ */
+// --------------------------------------------------------------------------
+void Chromocode::Reader::takeTag(int tag)
+{
+    if(peekTag() != tag)
+    {
+        throw invalid_argument("Chromocode node mismatch");
+    }
+    ++opNdx_;
+}
+
+
+// --------------------------------------------------------------------------
+// Reader::getVarint:
+// --------------------------------------------------------------------------
+/**
+ * Consumes an unsigned LEB128 integer from the opcode stream
+ */
+// --------------------------------------------------------------------------
+u_int Chromocode::Reader::getVarint()
+{
+    u_int n     = 0;
+    int   shift = 0;
+    u_char byte;
+
+    do
+    {
+        if(atEnd() || (shift > 28))
+        {
+            throw out_of_range("Bad chromocode varint");
+        }
+        byte   = code_.ops_[opNdx_++];
+        n     |= (u_int) (byte & 0x7F) << shift;
+        shift += 7;
+
+    } while(byte & 0x80);
+
+    return n;
+}
+
+
+} } // ns{ oi::genprog }
@@ -0,0 +1,134 @@
+/***************************************************************************/
+/**
+ * MODULE: ColumnWindow.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <stdexcept>
+#include <string>
+
+#include "genprog/ColumnWindow.hpp"
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// ColumnWindow:
+// --------------------------------------------------------------------------
+/**
+ * Constructor for a window over separately allocated columns
+ *
+ * @param cols      Attribute columns, oldest day first
+ * @param numRows   Days of data in each column
+ * @param winLen    Days in the sliding window
+ * @param targetNdx Index of the target attribute in cols (for Allele::TARGET)
+ * @param stride    Reals between consecutive days (1 for plain columns)
+ */
+// --------------------------------------------------------------------------
+ColumnWindow::ColumnWindow(const vector<const Real*>& cols,
+                           u_int                      numRows,
+                           u_int                      winLen,
+                           u_int                      targetNdx,
+                           u_int                      stride)
+  : cols_    (cols),
+    numRows_ (numRows),
+    winLen_  (winLen),
+    stride_  (stride),
+    firstDay_(0),
+    numDays_ (0),
+    cursor_  (0)
+{
+    if(targetNdx >= cols.size())
+    {
+        throw invalid_argument("Target attribute " + to_string(targetNdx) + " is not in the window");
+    }
+    if(!winLen_ || (winLen_ > numRows_))
+    {
+        throw invalid_argument("Window of " + to_string(winLen_) + " days for "
+                               + to_string(numRows_) + " days of data");
+    }
+
+    // The target rides along at the end, where viewNdx() expects it
+    cols_.push_back(cols[targetNdx]);
+    setRange(winLen_ - 1, numRows_ - winLen_ + 1);
+}
+
+
+// --------------------------------------------------------------------------
+// ColumnWindow:
+// --------------------------------------------------------------------------
+/**
+ * Constructor for a window over a (shared memory or cached) column block
+ *
+ * @param block     The price data
+ * @param winLen    Days in the sliding window
+ * @param targetNdx Index of the target attribute column (for Allele::TARGET)
+ */
+// --------------------------------------------------------------------------
+ColumnWindow::ColumnWindow(const util::ColumnBlock& block,
+                           u_int                    winLen,
+                           u_int                    targetNdx)
+  : ColumnWindow([&block]()
+                 {
+                     vector<const Real*> cols;
+
+                     for(size_t c = 0; c < block.getNumCols(); ++c)
+                     {
+                         cols.push_back(block.column(c));
+                     }
+                     return cols;
+                 }(),
+                 block.getNumRows(), winLen, targetNdx)
+{ }
+
+
+// --------------------------------------------------------------------------
+// setRange:
+// --------------------------------------------------------------------------
+/**
+ * Selects the days to evaluate and resolves every (attribute, offset)
+ * stream for them.  The cursor goes back to the first day.
+ *
+ * @param firstDay  Column row of the first evaluation day.  There must be
+ *                  a full window of data ending there.
+ * @param numDays   Number of days to evaluate
+ */
+// --------------------------------------------------------------------------
+void ColumnWindow::setRange(u_int firstDay, u_int numDays)
+{
+    if((firstDay + 1 < winLen_) || (firstDay + numDays > numRows_))
+    {
+        throw out_of_range("Evaluation days " + to_string(firstDay) + "+" + to_string(numDays)
+                           + " fall outside the data window");
+    }
+
+    firstDay_ = firstDay;
+    numDays_  = numDays;
+    cursor_   = 0;
+
+    // Offset 0 is the oldest day in the window
+    views_.resize(cols_.size() * winLen_);
+    for(size_t c = 0; c < cols_.size(); ++c)
+    {
+        const Real *oldest = cols_[c] + ((ptrdiff_t) (firstDay_ - winLen_ + 1) * stride_);
+
+        for(u_int offset = 0; offset < winLen_; ++offset)
+        {
+            views_[(c * winLen_) + offset] = oldest + (offset * stride_);
+        }
+    }
+}
+
+
+} } // ns{ oi::genprog }
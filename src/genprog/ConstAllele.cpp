@@ -57,7 +57,9 @@ typedef boost::singleton_pool<ConstAlleleMemPoolTag, sizeof(ConstAllele), boost:
  */
 // --------------------------------------------------------------------------
 ConstAllele::ConstAllele(Real val) : Value(val)
-{ }
+{
+    MemStats::created(MemStats::CONST_ALLELE, sizeof(ConstAllele));
+}
 
 
 // --------------------------------------------------------------------------
@@ -70,7 +72,9 @@ ConstAllele::ConstAllele(Real val) : Value(val)
  */
 // --------------------------------------------------------------------------
 ConstAllele::ConstAllele(const ConstAllele& that) : Value(that.Value)
-{ }
+{
+    MemStats::created(MemStats::CONST_ALLELE, sizeof(ConstAllele));
+}
 
 
 
@@ -101,6 +105,7 @@ void * ConstAllele::operator new(size_t size)
 
         if(p)
         {
+            MemStats::poolAlloc(MemStats::CONST_ALLELE_POOL);
             return p;
         }
 
@@ -133,7 +138,11 @@ void ConstAllele::operator delete(void *p, size_t size)
     if(p)
     {
         if(size != sizeof(ConstAllele)) ::operator delete(p);           // Global handler for weird stuff
-        else                            ConstAlleleMemPool::free(p);    // Normal pooled object deallocation
+        else
+        {
+            ConstAlleleMemPool::free(p);                                // Normal pooled object deallocation
+            MemStats::poolFree(MemStats::CONST_ALLELE_POOL);
+        }
     }
 }
 
@@ -208,7 +217,7 @@ Real ConstAllele::getSlidingReal()
 
     if(isPos < CFG_CHANCE_POSITIVE) wholePart *= -1;
 
-    return (isWhole < CFG_CHANCE_WHOLE) ? (Real) wholePart                  // Real whole number
+    return (isWhole < CFG_CHANCE_WHOLE) ? (Real) wholePart                    // Real whole number
                                         : (Real) wholePart + drand48();     // Real decimal number
 }
 
@@ -0,0 +1,180 @@
+/***************************************************************************/
+/**
+ * MODULE: EvoStats.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <algorithm>
+
+#include "genprog/EvoStats.hpp"
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+
+/***************************************************************************/
+/* STATIC DATA                                                             */
+/***************************************************************************/
+thread_local EvoStats::Counters    *EvoStats::Mine          = nullptr;
+mutex                               EvoStats::RegistryLock;
+vector<EvoStats::Counters*>         EvoStats::Registry;
+EvoStats::Snapshot                  EvoStats::Retired       = { 0, 0, 0, FITNESS_UNFIT, -1.0 };
+Real                                EvoStats::TargetFitness = 0.0;
+EvoStats::Clock::time_point         EvoStats::StartTime;
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// reset:
+// --------------------------------------------------------------------------
+/**
+ * Zeroes all counters and starts the clock for time-to-target.  Call this
+ * between runs, while no evolution is going on.
+ *
+ * @param targetFitness Fitness that counts as reaching the target
+ */
+// --------------------------------------------------------------------------
+void EvoStats::reset(Real targetFitness)
+{
+    lock_guard<mutex> lock(RegistryLock);
+
+    TargetFitness = targetFitness;
+    StartTime     = Clock::now();
+    Retired       = { 0, 0, 0, FITNESS_UNFIT, -1.0 };
+
+    for(Counters *c : Registry)
+    {
+        c->evaluations_    = 0;
+        c->treeEvals_      = 0;
+        c->nodesEvaluated_ = 0;
+        c->bestFitness_    = FITNESS_UNFIT;
+        c->reachedNs_      = 0;
+    }
+}
+
+
+// --------------------------------------------------------------------------
+// snapshot:
+// --------------------------------------------------------------------------
+/**
+ * Totals the counters across all threads
+ *
+ * @return  Counts since the last reset()
+ */
+// --------------------------------------------------------------------------
+EvoStats::Snapshot EvoStats::snapshot()
+{
+    lock_guard<mutex> lock(RegistryLock);
+
+    Snapshot snap       = Retired;
+    int64_t  reachedNs  = 0;
+
+    for(Counters *c : Registry)
+    {
+        int64_t ns = c->reachedNs_.load(memory_order_relaxed);
+
+        snap.evaluations_    += c->evaluations_.load(memory_order_relaxed);
+        snap.treeEvals_      += c->treeEvals_.load(memory_order_relaxed);
+        snap.nodesEvaluated_ += c->nodesEvaluated_.load(memory_order_relaxed);
+        snap.bestFitness_     = max(snap.bestFitness_, c->bestFitness_.load(memory_order_relaxed));
+
+        if(ns && (!reachedNs || (ns < reachedNs)))
+        {
+            reachedNs = ns;
+        }
+    }
+    if(reachedNs && ((snap.secsToTarget_ < 0.0) || (reachedNs / 1e9 < snap.secsToTarget_)))
+    {
+        snap.secsToTarget_ = reachedNs / 1e9;
+    }
+    return snap;
+}
+
+
+/***************************************************************************/
+/* PRIVATE CLASS METHODS                                                   */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// addCounters:
+// --------------------------------------------------------------------------
+/**
+ * Registers a counter block for the calling thread, and arranges for it to
+ * be retired when the thread exits
+ */
+// --------------------------------------------------------------------------
+EvoStats::Counters& EvoStats::addCounters()
+{
+    static thread_local Retirer retirer;
+
+    Counters *c = new Counters();
+
+    c->bestFitness_ = FITNESS_UNFIT;
+    {
+        lock_guard<mutex> lock(RegistryLock);
+        Registry.push_back(c);
+    }
+    Mine = c;
+    return *c;
+}
+
+
+// --------------------------------------------------------------------------
+// retireCounters:
+// --------------------------------------------------------------------------
+/**
+ * Folds the calling thread's counts into the retired totals and frees its
+ * block.  The thread is exiting, so nothing else writes the block.
+ */
+// --------------------------------------------------------------------------
+void EvoStats::retireCounters()
+{
+    Counters *c = Mine;
+
+    if(!c)
+    {
+        return;
+    }
+
+    lock_guard<mutex> lock(RegistryLock);
+    int64_t           ns = c->reachedNs_.load(memory_order_relaxed);
+
+    Retired.evaluations_    += c->evaluations_.load(memory_order_relaxed);
+    Retired.treeEvals_      += c->treeEvals_.load(memory_order_relaxed);
+    Retired.nodesEvaluated_ += c->nodesEvaluated_.load(memory_order_relaxed);
+    Retired.bestFitness_     = max(Retired.bestFitness_, c->bestFitness_.load(memory_order_relaxed));
+
+    if(ns && ((Retired.secsToTarget_ < 0.0) || (ns / 1e9 < Retired.secsToTarget_)))
+    {
+        Retired.secsToTarget_ = ns / 1e9;
+    }
+
+    Registry.erase(remove(Registry.begin(), Registry.end(), c), Registry.end());
+    delete c;
+    Mine = nullptr;
+}
+
+
+// --------------------------------------------------------------------------
+// ~Retirer:
+// --------------------------------------------------------------------------
+/**
+ * Runs at thread exit
+ */
+// --------------------------------------------------------------------------
+EvoStats::Retirer::~Retirer()
+{
+    retireCounters();
+}
+
+
+} } // ns{ oi::genprog }
@@ -0,0 +1,422 @@
+/***************************************************************************/
+/**
+ * MODULE: GeneTree.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "genprog/GeneTree.hpp"
+#include "genprog/MemStats.hpp"
+#include "genprog/OpKernels.hpp"
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+
+/***************************************************************************/
+/* CONSTANTS                                                               */
+/***************************************************************************/
+static_assert(sizeof(GeneTree::Node) == 16, "GeneTree::Node should pack into 16 bytes");
+
+static const u_int MAX_LAG = UINT16_MAX;        ///< Deepest lookup a Node can hold
+
+
+/***************************************************************************/
+/* PRIVATE METHODS                                                         */
+/***************************************************************************/
+
+// ---------------------------------------------------------------- STATIC --
+// apply:
+// --------------------------------------------------------------------------
+/**
+ * The GP functions, one specialization per wire opcode, with the same
+ * protected semantics as the kernels in OpKernelSet.hpp.  Unary functions
+ * ignore y.
+ */
+// --------------------------------------------------------------------------
+template<u_char OP> static inline Real apply(Real x, Real y);
+
+template<> inline Real apply<Chromocode::OP_ADD> (Real x, Real y) { return x + y; }
+template<> inline Real apply<Chromocode::OP_SUB> (Real x, Real y) { return x - y; }
+template<> inline Real apply<Chromocode::OP_MUL> (Real x, Real y) { return x * y; }
+template<> inline Real apply<Chromocode::OP_DIV> (Real x, Real y) { return (y != 0.0) ? (x / y) : 1.0; }
+template<> inline Real apply<Chromocode::OP_INV> (Real x, Real)   { return (x != 0.0) ? (1.0 / x) : 1.0; }
+template<> inline Real apply<Chromocode::OP_NEG> (Real x, Real)   { return -x; }
+template<> inline Real apply<Chromocode::OP_ABS> (Real x, Real)   { return fabs(x); }
+template<> inline Real apply<Chromocode::OP_SQRT>(Real x, Real)   { return sqrt(fabs(x)); }
+template<> inline Real apply<Chromocode::OP_CBRT>(Real x, Real)   { return cbrt(x); }
+template<> inline Real apply<Chromocode::OP_SIN> (Real x, Real)   { return sin(x); }
+template<> inline Real apply<Chromocode::OP_COS> (Real x, Real)   { return cos(x); }
+template<> inline Real apply<Chromocode::OP_TAN> (Real x, Real)   { return tan(x); }
+template<> inline Real apply<Chromocode::OP_LOG> (Real x, Real)   { return log((x != 0.0) ? fabs(x) : 1.0); }
+template<> inline Real apply<Chromocode::OP_EXP> (Real x, Real)   { return exp(x); }
+template<> inline Real apply<Chromocode::OP_MIN> (Real x, Real y) { return (x < y) ? x : y; }
+template<> inline Real apply<Chromocode::OP_MAX> (Real x, Real y) { return (x > y) ? x : y; }
+template<> inline Real apply<Chromocode::OP_SQR> (Real x, Real)   { return x * x; }
+template<> inline Real apply<Chromocode::OP_CUBE>(Real x, Real)   { return x * x * x; }
+template<> inline Real apply<Chromocode::OP_AVG> (Real x, Real y) { return (x + y) * 0.5; }
+
+template<> inline Real apply<Chromocode::OP_POW> (Real x, Real y)
+{
+    const Real p = pow(fabs(x), y);
+
+    return isfinite(p) ? p : 1.0;
+}
+
+
+// --------------------------------------------------------------------------
+// decode:
+// --------------------------------------------------------------------------
+/**
+ * Appends a node, and everything under it, from a Chromocode
+ *
+ * @param code      Reader positioned at the node
+ * @param parent    Index of the node's parent (NO_NODE for the root)
+ * @param depth     The node's level in the tree (1 for the root)
+ */
+// --------------------------------------------------------------------------
+void GeneTree::decode(Chromocode::Reader& code, uint32_t parent, u_int depth)
+{
+    const uint32_t ndx  = nodes_.size();
+    Node           node = { parent, 1, NO_NODE, 0, 0, 0 };
+    u_int          lag  = 0;
+
+    node.type_ = code.peekTag();
+    switch(node.type_)
+    {
+        case Allele::Const:
+            node.data_ = consts_.size();
+            consts_.push_back(code.getConst());
+            break;
+
+        case Allele::Func:
+            node.opcode_ = code.getFunc();
+            break;
+
+        case Allele::Lookup:
+            code.getLookup(node.data_, lag);
+            if(lag > MAX_LAG)
+            {
+                throw out_of_range("Lookup lag " + to_string(lag) + " is too deep for a GeneTree");
+            }
+            node.lag_ = lag;
+            maxLag_   = max(maxLag_, lag);
+            break;
+
+        default:
+            throw invalid_argument("Unknown chromocode allele type");
+    }
+    height_ = max(height_, depth);
+    nodes_.push_back(node);
+
+    if(Allele::Func == node.type_)
+    {
+        decode(code, ndx, depth + 1);
+        if(Chromocode::getOpInfo(node.opcode_).arity_ > 1)
+        {
+            nodes_[ndx].data_ = nodes_.size();
+            decode(code, ndx, depth + 1);
+        }
+    }
+    nodes_[ndx].nodeCnt_ = nodes_.size() - ndx;
+}
+
+
+// --------------------------------------------------------------------------
+// valueAt:
+// --------------------------------------------------------------------------
+/**
+ * Evaluates a subtree for the window's current (cursor) day
+ *
+ * @param ndx   The subtree's root node
+ * @param win   The price data
+ *
+ * @return      The subtree's value
+ */
+// --------------------------------------------------------------------------
+Real GeneTree::valueAt(u_int ndx, const ColumnWindow& win) const
+{
+    using C = Chromocode;
+
+    const Node& node = nodes_[ndx];
+
+    switch(node.type_)
+    {
+        case Allele::Const:     return consts_[node.data_];
+        case Allele::Lookup:    return win.lookup(node.data_, node.lag_);
+        default:                break;
+    }
+
+    // The first argument is right behind us
+    const Real x = valueAt(ndx + 1, win);
+
+    switch(node.opcode_)
+    {
+        case C::OP_INV:         return apply<C::OP_INV> (x, x);
+        case C::OP_NEG:         return apply<C::OP_NEG> (x, x);
+        case C::OP_ABS:         return apply<C::OP_ABS> (x, x);
+        case C::OP_SQRT:        return apply<C::OP_SQRT>(x, x);
+        case C::OP_CBRT:        return apply<C::OP_CBRT>(x, x);
+        case C::OP_SIN:         return apply<C::OP_SIN> (x, x);
+        case C::OP_COS:         return apply<C::OP_COS> (x, x);
+        case C::OP_TAN:         return apply<C::OP_TAN> (x, x);
+        case C::OP_LOG:         return apply<C::OP_LOG> (x, x);
+        case C::OP_EXP:         return apply<C::OP_EXP> (x, x);
+        case C::OP_SQR:         return apply<C::OP_SQR> (x, x);
+        case C::OP_CUBE:        return apply<C::OP_CUBE>(x, x);
+        default:                break;
+    }
+
+    // ...and the second is linked
+    const Real y = valueAt(node.data_, win);
+
+    switch(node.opcode_)
+    {
+        case C::OP_ADD:         return apply<C::OP_ADD> (x, y);
+        case C::OP_SUB:         return apply<C::OP_SUB> (x, y);
+        case C::OP_MUL:         return apply<C::OP_MUL> (x, y);
+        case C::OP_DIV:         return apply<C::OP_DIV> (x, y);
+        case C::OP_POW:         return apply<C::OP_POW> (x, y);
+        case C::OP_MIN:         return apply<C::OP_MIN> (x, y);
+        case C::OP_MAX:         return apply<C::OP_MAX> (x, y);
+        case C::OP_AVG:         return apply<C::OP_AVG> (x, y);
+        default:                throw logic_error("No GeneTree function for opcode " + to_string(node.opcode_));
+    }
+}
+
+
+// --------------------------------------------------------------------------
+// blockAt:
+// --------------------------------------------------------------------------
+/**
+ * Evaluates a subtree for a block of days through the OpKernels
+ *
+ * @param ndx       The subtree's root node
+ * @param win       The price data
+ * @param firstDay  First day of the block (relative to the window's range)
+ * @param numDays   Days in the block
+ * @param slot      Where the result goes.  The slots after it are free for
+ *                  the subtree to use, numDays at a time.
+ *
+ * @return          The subtree's values: slot, or a packed window stream
+ */
+// --------------------------------------------------------------------------
+const Real* GeneTree::blockAt(u_int               ndx,
+                              const ColumnWindow& win,
+                              u_int               firstDay,
+                              u_int               numDays,
+                              Real               *slot) const
+{
+    const Node& node = nodes_[ndx];
+
+    switch(node.type_)
+    {
+        case Allele::Const:
+            fill(slot, slot + numDays, consts_[node.data_]);
+            return slot;
+
+        case Allele::Lookup:
+        {
+            const ptrdiff_t stride = win.getStride();
+            const Real     *stream = win.stream(node.data_, node.lag_) + (firstDay * stride);
+
+            if(1 == stride)
+            {
+                return stream;              // No need to copy
+            }
+            for(u_int d = 0; d < numDays; ++d)
+            {
+                slot[d] = stream[d * stride];
+            }
+            return slot;
+        }
+
+        default:
+            break;
+    }
+
+    // The first argument can work in our slot, since the kernels work in place
+    const Real *x = blockAt(ndx + 1, win, firstDay, numDays, slot);
+    const Real *y = x;
+
+    if(node.data_ != NO_NODE)
+    {
+        y = blockAt(node.data_, win, firstDay, numDays, slot + numDays);
+    }
+
+    OpKernels::get(node.opcode_)(slot, x, y, numDays);
+    return slot;
+}
+
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// GeneTree:
+// --------------------------------------------------------------------------
+/**
+ * Creates a tree with a single 0 constant
+ */
+// --------------------------------------------------------------------------
+GeneTree::GeneTree()
+  : nodes_ (1, Node { NO_NODE, 1, 0, Allele::Const, 0, 0 }),
+    consts_(1, 0.0),
+    height_(1),
+    maxLag_(0)
+{
+    MemStats::created(MemStats::GENE_TREE, getBytes());
+}
+
+
+// --------------------------------------------------------------------------
+// GeneTree:
+// --------------------------------------------------------------------------
+/**
+ * Creates a copy of another tree
+ *
+ * @param that  The tree we're copying
+ */
+// --------------------------------------------------------------------------
+GeneTree::GeneTree(const GeneTree& that)
+  : nodes_ (that.nodes_),
+    consts_(that.consts_),
+    height_(that.height_),
+    maxLag_(that.maxLag_)
+{
+    MemStats::created(MemStats::GENE_TREE, getBytes());
+}
+
+
+// --------------------------------------------------------------------------
+// GeneTree:
+// --------------------------------------------------------------------------
+/**
+ * Builds the tree for a chromosome
+ *
+ * @param code  The chromosome's Chromocode (see Individual::encode)
+ */
+// --------------------------------------------------------------------------
+GeneTree::GeneTree(const Chromocode& code)
+  : height_(0),
+    maxLag_(0)
+{
+    Chromocode::Reader reader(code);
+
+    nodes_.reserve(code.getNodeCnt());
+    decode(reader, NO_NODE, 1);
+
+    if(!reader.atEnd())
+    {
+        throw invalid_argument("Chromocode has nodes past the end of its tree");
+    }
+    MemStats::created(MemStats::GENE_TREE, getBytes());
+}
+
+
+// --------------------------------------------------------------------------
+// ~GeneTree:
+// --------------------------------------------------------------------------
+/**
+ * Tear down the tree
+ */
+// --------------------------------------------------------------------------
+GeneTree::~GeneTree()
+{
+    MemStats::destroyed(MemStats::GENE_TREE, getBytes());
+}
+
+
+// --------------------------------------------------------------------------
+// operator=:
+// --------------------------------------------------------------------------
+/**
+ * Makes this tree a copy of another
+ *
+ * @param rhs   The tree we're copying
+ *
+ * @return      This tree
+ */
+// --------------------------------------------------------------------------
+GeneTree& GeneTree::operator=(const GeneTree& rhs)
+{
+    if(this != &rhs)
+    {
+        MemStats::destroyed(MemStats::GENE_TREE, getBytes());
+        nodes_  = rhs.nodes_;
+        consts_ = rhs.consts_;
+        height_ = rhs.height_;
+        maxLag_ = rhs.maxLag_;
+        MemStats::created(MemStats::GENE_TREE, getBytes());
+    }
+    return *this;
+}
+
+
+// --------------------------------------------------------------------------
+// encode:
+// --------------------------------------------------------------------------
+/**
+ * Returns the tree's Chromocode.  The nodes are already in prefix order, so
+ * this is a straight run through them.
+ */
+// --------------------------------------------------------------------------
+Chromocode GeneTree::encode() const
+{
+    Chromocode code;
+
+    for(const Node& node : nodes_)
+    {
+        switch(node.type_)
+        {
+            case Allele::Const:     code.putConst(consts_[node.data_]);         break;
+            case Allele::Func:      code.putFunc(node.opcode_);                 break;
+            default:                code.putLookup(node.data_, node.lag_);      break;
+        }
+    }
+    return code;
+}
+
+
+// --------------------------------------------------------------------------
+// evalBlock:
+// --------------------------------------------------------------------------
+/**
+ * Evaluates the tree for a block of days at once, a node at a time through
+ * the batched OpKernels.  Working memory is getHeight() blocks of numDays.
+ *
+ * @param win       The price data
+ * @param firstDay  First day of the block (relative to the window's range)
+ * @param numDays   Days in the block
+ * @param scratch   Working memory.  Keep it around between calls (e.g., one
+ *                  per thread) so it only grows once.
+ *
+ * @return          The tree's value for each day in the block.  The values
+ *                  are good until the next call with the same scratch.
+ */
+// --------------------------------------------------------------------------
+const Real* GeneTree::evalBlock(const ColumnWindow& win,
+                                u_int               firstDay,
+                                u_int               numDays,
+                                vector<Real>&       scratch) const
+{
+    if(scratch.size() < (size_t) height_ * numDays)
+    {
+        scratch.resize((size_t) height_ * numDays);
+    }
+    return blockAt(0, win, firstDay, numDays, scratch.data());
+}
+
+
+} } // ns{ oi::genprog }
@@ -56,7 +56,9 @@ Individual::Individual() :  chromosome_ (),
                             isDead_     (false),
                             isSick_     (true),
                             fitness_    (FITNESS_UNFIT)
-{ }
+{
+    MemStats::created(MemStats::INDIVIDUAL, sizeof(Individual));
+}
 
 // --------------------------------------------------------------------------
 // CONSTRUCTOR:
@@ -73,7 +75,7 @@ Individual::Individual(const Individual& that)
      isSick_     (that.isSick_),
      fitness_    (FITNESS_UNFIT)
 {
-
+    MemStats::created(MemStats::INDIVIDUAL, sizeof(Individual));
 }
 
 // --------------------------------------------------------------------------
@@ -90,7 +92,9 @@ Individual::Individual(const World& world)
      isDead_     (false),
      isSick_     (false),
      fitness_    (FITNESS_UNFIT)
-{ }
+{
+    MemStats::created(MemStats::INDIVIDUAL, sizeof(Individual));
+}
 
 
 // --------------------------------------------------------------------------
@@ -107,7 +111,9 @@ Individual::Individual(const World& world, const string& func)
      isDead_     (false),
      isSick_     (false),
      fitness_    (FITNESS_UNFIT)
-{ }
+{
+    MemStats::created(MemStats::INDIVIDUAL, sizeof(Individual));
+}
 
 
 
@@ -138,6 +144,7 @@ void * Individual::operator new(size_t size)
 
         if(p)
         {
+            MemStats::poolAlloc(MemStats::INDIVIDUAL_POOL);
             return p;
         }
 
@@ -170,7 +177,11 @@ void Individual::operator delete(void *p, size_t size)
     if(p)
     {
         if(size != sizeof(Individual))  ::operator delete(p);    // Global handler for weird stuff
-        else                            MemPool::free(p);           // Normal pooled object deallocation
+        else
+        {
+            MemPool::free(p);                                       // Normal pooled object deallocation
+            MemStats::poolFree(MemStats::INDIVIDUAL_POOL);
+        }
     }
 }
 
@@ -197,7 +208,8 @@ bool Individual::mate(const Individual_p& he,
                       u_int               babyNdx2,
                       Real                mutationRate) const
 {
-    bool gaveBirth = false;
+    Telemetry::PhaseTimer timer(Telemetry::REPRODUCTION);
+    bool                  gaveBirth = false;
 
     assert(canReproduce());
     assert(he->canReproduce());
@@ -0,0 +1,113 @@
+/***************************************************************************/
+/**
+ * MODULE: MemStats.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include "genprog/MemStats.hpp"
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+
+/***************************************************************************/
+/* STATIC DATA                                                             */
+/***************************************************************************/
+MemStats::Counter       MemStats::Live[NUM_KINDS];
+MemStats::Counter       MemStats::Pools[NUM_POOLS];
+MemStats::Counter       MemStats::PoolHighs[NUM_POOLS];
+MemStats::ByteCounter   MemStats::LiveBytes;
+MemStats::ByteCounter   MemStats::PeakBytes;
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// ---------------------------------------------------------------- STATIC --
+// getLive:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of live objects of a kind
+ */
+// --------------------------------------------------------------------------
+long MemStats::getLive(Kind kind)
+{
+    return Live[kind].count_.load(memory_order_relaxed);
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getLiveBytes:
+// --------------------------------------------------------------------------
+/**
+ * Returns the bytes taken up by the live objects that report their size
+ */
+// --------------------------------------------------------------------------
+size_t MemStats::getLiveBytes()
+{
+    return LiveBytes.bytes_.load(memory_order_relaxed);
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getPeakBytes:
+// --------------------------------------------------------------------------
+/**
+ * Returns the most live bytes seen since the last resetPeak()
+ */
+// --------------------------------------------------------------------------
+size_t MemStats::getPeakBytes()
+{
+    return PeakBytes.bytes_.load(memory_order_relaxed);
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getPoolBlocks:
+// --------------------------------------------------------------------------
+/**
+ * Returns the number of blocks a memory pool has handed out and not yet
+ * taken back
+ */
+// --------------------------------------------------------------------------
+long MemStats::getPoolBlocks(Pool pool)
+{
+    return Pools[pool].count_.load(memory_order_relaxed);
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getPoolHighWater:
+// --------------------------------------------------------------------------
+/**
+ * Returns the most blocks a memory pool has had out at once.  Pools keep
+ * their memory until the program ends, so this is what the pool costs us.
+ */
+// --------------------------------------------------------------------------
+long MemStats::getPoolHighWater(Pool pool)
+{
+    return PoolHighs[pool].count_.load(memory_order_relaxed);
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// resetPeak:
+// --------------------------------------------------------------------------
+/**
+ * Starts tracking a new peak from the current live bytes, e.g., for a job
+ */
+// --------------------------------------------------------------------------
+void MemStats::resetPeak()
+{
+    PeakBytes.bytes_.store(LiveBytes.bytes_.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+
+} } // ns{ oi::genprog }
@@ -0,0 +1,83 @@
+/*\***********************************************************************\*//**
+ * MODULE: OpKernelSet.hpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ *//**********************************************************************\*///
+
+// --------------------------------------------------------------------------
+// The GPFunction kernels for one SIMD level.
+//
+// OpKernels.cpp includes this file once per level, each time inside its own
+// namespace and under that level's "#pragma GCC target".  There is no include
+// guard on purpose, and nothing here may #include anything.  The loops are
+// "omp simd" (-fopenmp-simd), so they vectorize at any -O level.  Protected
+// functions pick their safe value with selects rather than branches.
+//
+// KERNELS must stay in Chromocode wire opcode order.
+// --------------------------------------------------------------------------
+
+#define UNARY_KERNEL(NAME, EXPR)                                                \
+    static void NAME(Real *out, const Real *x, const Real *, u_int n)           \
+    {                                                                           \
+        _Pragma("omp simd")                                                     \
+        for(u_int i = 0; i < n; ++i)                                            \
+        {                                                                       \
+            const Real a = x[i];                                                \
+            out[i] = (EXPR);                                                    \
+        }                                                                       \
+    }
+
+#define BINARY_KERNEL(NAME, EXPR)                                               \
+    static void NAME(Real *out, const Real *x, const Real *y, u_int n)          \
+    {                                                                           \
+        _Pragma("omp simd")                                                     \
+        for(u_int i = 0; i < n; ++i)                                            \
+        {                                                                       \
+            const Real a = x[i];                                                \
+            const Real b = y[i];                                                \
+            out[i] = (EXPR);                                                    \
+        }                                                                       \
+    }
+
+BINARY_KERNEL(ADD,  a + b)
+BINARY_KERNEL(SUB,  a - b)
+BINARY_KERNEL(MUL,  a * b)
+BINARY_KERNEL(DIV,  (b != 0.0) ? (a / ((b != 0.0) ? b : 1.0)) : 1.0)     // x/0 = 1
+UNARY_KERNEL (INV,  (a != 0.0) ? (1.0 / ((a != 0.0) ? a : 1.0)) : 1.0)   // 1/0 = 1
+UNARY_KERNEL (NEG,  -a)
+UNARY_KERNEL (ABS,  std::fabs(a))
+UNARY_KERNEL (SQRT, std::sqrt(std::fabs(a)))                            // sqrt(|x|)
+UNARY_KERNEL (CBRT, std::cbrt(a))
+UNARY_KERNEL (SIN,  std::sin(a))
+UNARY_KERNEL (COS,  std::cos(a))
+UNARY_KERNEL (TAN,  std::tan(a))
+UNARY_KERNEL (LOG,  std::log((a != 0.0) ? std::fabs(a) : 1.0))          // log|x|, log 0 = 0
+UNARY_KERNEL (EXP,  std::exp(a))
+BINARY_KERNEL(MIN,  (a < b) ? a : b)
+BINARY_KERNEL(MAX,  (a > b) ? a : b)
+UNARY_KERNEL (SQR,  a * a)
+UNARY_KERNEL (CUBE, a * a * a)
+BINARY_KERNEL(AVG,  (a + b) * 0.5)
+
+#undef UNARY_KERNEL
+#undef BINARY_KERNEL
+
+static void POW(Real *out, const Real *x, const Real *y, u_int n)              // |x|^y, 1 if not finite
+{
+    #pragma omp simd
+    for(u_int i = 0; i < n; ++i)
+    {
+        const Real p = std::pow(std::fabs(x[i]), y[i]);
+
+        out[i] = std::isfinite(p) ? p : 1.0;
+    }
+}
+
+static const OpKernels::Kernel KERNELS[] = { ADD,  SUB,  MUL,  DIV,            //  0 -  3
+                                             INV,  NEG,  ABS,  SQRT,           //  4 -  7
+                                             CBRT, POW,  SIN,  COS,            //  8 - 11
+                                             TAN,  LOG,  EXP,  MIN,            // 12 - 15
+                                             MAX,  SQR,  CUBE, AVG };          // 16 - 19
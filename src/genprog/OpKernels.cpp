@@ -0,0 +1,113 @@
+/***************************************************************************/
+/**
+ * MODULE: OpKernels.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "genprog/OpKernels.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define SIMD_DISPATCH 1       ///< Build the AVX2 and AVX-512 kernel sets
+#endif
+
+namespace oi { namespace genprog {
+
+using namespace std;
+using util::HardwareProbe;
+
+
+/***************************************************************************/
+/* KERNEL SETS                                                             */
+/***************************************************************************/
+namespace base {
+#include "OpKernelSet.hpp"
+}
+
+#if SIMD_DISPATCH
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace avx2 {
+#include "OpKernelSet.hpp"
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,prefer-vector-width=512")
+namespace avx512 {
+#include "OpKernelSet.hpp"
+}
+#pragma GCC pop_options
+#endif
+
+
+/***************************************************************************/
+/* CONSTANTS                                                               */
+/***************************************************************************/
+#ifdef __SSE2__
+static const OpKernels::SIMD BASE_LEVEL = HardwareProbe::SIMD_SSE2;    ///< What the build targets
+#else
+static const OpKernels::SIMD BASE_LEVEL = HardwareProbe::SIMD_NONE;
+#endif
+
+
+/***************************************************************************/
+/* STATIC DATA                                                             */
+/***************************************************************************/
+const OpKernels::Kernel *OpKernels::Table = base::KERNELS;
+OpKernels::SIMD          OpKernels::Level = BASE_LEVEL;
+
+static const OpKernels::SIMD Selected = OpKernels::select(HardwareProbe::getSIMD());  ///< Startup choice
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// ---------------------------------------------------------------- STATIC --
+// select:
+// --------------------------------------------------------------------------
+/**
+ * Selects the widest kernel set the CPU supports, up to a limit.  This
+ * happens on its own at startup; call it again to hold the kernels to a
+ * lower level (e.g., to compare levels).  Don't call it while evaluation
+ * threads are running.
+ *
+ * @param maxLevel  Highest SIMD level to use
+ *
+ * @return          The SIMD level selected
+ */
+// --------------------------------------------------------------------------
+OpKernels::SIMD OpKernels::select(SIMD maxLevel)
+{
+    SIMD level = min(maxLevel, HardwareProbe::getSIMD());
+
+#if SIMD_DISPATCH
+    if(level >= HardwareProbe::SIMD_AVX512)
+    {
+        Table = avx512::KERNELS;
+        Level = HardwareProbe::SIMD_AVX512;
+    }
+    else if(level >= HardwareProbe::SIMD_AVX2)
+    {
+        Table = avx2::KERNELS;
+        Level = HardwareProbe::SIMD_AVX2;
+    }
+    else
+#endif
+    {
+        Table = base::KERNELS;
+        Level = BASE_LEVEL;
+    }
+    return Level;
+}
+
+
+} } // ns{ oi::genprog }
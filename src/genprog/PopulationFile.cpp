@@ -0,0 +1,264 @@
+/***************************************************************************/
+/**
+ * MODULE: PopulationFile.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "genprog/PopulationFile.hpp"
+
+#ifndef SHAREDSTATEDIR
+#  define SHAREDSTATEDIR "."
+#endif
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+
+/***************************************************************************/
+/* CONSTANTS                                                               */
+/***************************************************************************/
+static const char    MAGIC[4] = { 'S', 'P', 'O', 'P' };    ///< Population file signature
+static const uint8_t VERSION  = 1;                          ///< Population file version
+
+static const size_t  HEADER_SIZE = sizeof(MAGIC) + sizeof(uint8_t) + sizeof(uint32_t);    ///< Magic, version, count
+static const size_t  ENTRY_SIZE  = sizeof(Real) + sizeof(uint32_t);                         ///< Fitness, length (code follows)
+
+
+/***************************************************************************/
+/* TYPE DEFINITIONS                                                        */
+/***************************************************************************/
+
+/**
+ * A saved individual, before we decide whether to bring him back
+ */
+struct Saved
+{
+    Real        fitness_;           ///< Fitness at the end of the last run
+    Chromocode  code_;              ///< His chromosome
+};
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// ---------------------------------------------------------------- STATIC --
+// pathFor:
+// --------------------------------------------------------------------------
+/**
+ * Returns the standard population file for a job
+ *
+ * @param jobName   The job (world) name, e.g., "SPY.close.5"
+ *
+ * @return          /path/to/population/jobName.pop
+ */
+// --------------------------------------------------------------------------
+string PopulationFile::pathFor(const string& jobName)
+{
+    return SHAREDSTATEDIR "/population/" + jobName + ".pop";
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// save:
+// --------------------------------------------------------------------------
+/**
+ * Writes the living members of a population to a file.  The file is
+ * replaced atomically, so a crash mid-save leaves yesterday's file intact,
+ * as does a chromosome that can't be encoded.
+ *
+ * @param path          Population file
+ * @param population    The World's (final) population
+ *
+ * @return              Number of individuals saved
+ */
+// --------------------------------------------------------------------------
+size_t PopulationFile::save(const string&        path,
+                            const Individual_Vp& population)
+{
+    string   tmpPath = path + ".tmp";
+    ofstream file(tmpPath.c_str(), ios::binary | ios::trunc);
+    uint32_t count   = 0;
+
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    file.write(reinterpret_cast<const char*>(&count),   sizeof(count));       // Placeholder
+
+    try
+    {
+        for(auto& guy : population)
+        {
+            if(guy && !guy->isDead())
+            {
+                Real     fitness = guy->getFitness();
+                string   bytes   = guy->encode().pack();
+                uint32_t len     = bytes.size();
+
+                file.write(reinterpret_cast<const char*>(&fitness), sizeof(fitness));
+                file.write(reinterpret_cast<const char*>(&len),     sizeof(len));
+                file.write(bytes.data(), len);
+                ++count;
+            }
+        }
+    }
+    catch(logic_error&)
+    {
+        file.close();
+        remove(tmpPath.c_str());
+        return 0;
+    }
+
+    file.seekp(sizeof(MAGIC) + sizeof(VERSION));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.close();
+
+    if(!file.good() || (rename(tmpPath.c_str(), path.c_str()) != 0))
+    {
+        remove(tmpPath.c_str());
+        return 0;
+    }
+    return count;
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// load:
+// --------------------------------------------------------------------------
+/**
+ * Brings back (up to) maxCount individuals from a population file, thinned
+ * for diversity.  A missing or damaged file simply yields no ancestors, and
+ * the World should fill its population with random individuals.  Neither
+ * the count nor any code length is trusted past what the file can hold, and
+ * individuals whose fitness isn't finite stay dead.
+ *
+ * @param path      Population file
+ * @param maxCount  Maximum number of individuals to bring back
+ * @param ancestors Output: the ancestors' chromosomes, fittest first
+ *
+ * @return          Number of individuals loaded
+ */
+// --------------------------------------------------------------------------
+size_t PopulationFile::load(const string&       path,
+                            size_t              maxCount,
+                            vector<Chromocode>& ancestors)
+{
+    ifstream      file(path.c_str(), ios::binary);
+    char          magic[sizeof(MAGIC)];
+    uint8_t       version = 0;
+    uint32_t      count   = 0;
+    vector<Saved> saved;
+
+    ancestors.clear();
+
+    file.seekg(0, ios::end);
+    streamoff fileSize = file.tellg();
+    file.seekg(0, ios::beg);
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&count),   sizeof(count));
+    if(!file.good() || !equal(magic, magic + sizeof(MAGIC), MAGIC) || (VERSION != version))
+    {
+        return 0;
+    }
+
+    // Every entry takes at least ENTRY_SIZE bytes, so a count the file can't
+    // hold means the header is garbage
+    size_t remaining = fileSize - HEADER_SIZE;
+
+    if(count > remaining / ENTRY_SIZE)
+    {
+        return 0;
+    }
+
+    // Read 'em all in, dropping structural duplicates as we go
+    unordered_set<uint64_t> seen;
+
+    saved.reserve(count);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        Real     fitness;
+        uint32_t len;
+        string   bytes;
+
+        file.read(reinterpret_cast<char*>(&fitness), sizeof(fitness));
+        file.read(reinterpret_cast<char*>(&len),     sizeof(len));
+        remaining -= ENTRY_SIZE;
+        if(!file.good() || (len > remaining))
+        {
+            return 0;
+        }
+        bytes.resize(len);
+        file.read(&bytes[0], len);
+        remaining -= len;
+        if(!file.good())
+        {
+            return 0;
+        }
+        if(!isfinite(fitness))
+        {
+            continue;                   // Died in its last evaluation
+        }
+
+        try
+        {
+            Chromocode code = Chromocode::unpack(bytes);
+
+            if(seen.insert(code.hash()).second)
+            {
+                saved.push_back(Saved { fitness, code });
+            }
+        }
+        catch(exception& e)
+        {
+            // Skip anything from an incompatible build
+        }
+    }
+
+    // Fittest first
+    stable_sort(saved.begin(), saved.end(),
+                [](const Saved& a, const Saved& b) { return a.fitness_ > b.fitness_; });
+
+    // Thin: half the slots for the elite, the rest spread across the other ranks
+    vector<size_t> picks;
+    size_t         numElite = min(saved.size(), (maxCount + 1) / 2);
+
+    for(size_t i = 0; i < numElite; ++i)
+    {
+        picks.push_back(i);
+    }
+    if(saved.size() > numElite)
+    {
+        size_t numRest = min(saved.size() - numElite, maxCount - numElite);
+        double stride  = (double) (saved.size() - numElite) / max<size_t>(numRest, 1);
+
+        for(size_t i = 0; i < numRest; ++i)
+        {
+            picks.push_back(numElite + (size_t) (i * stride));
+        }
+    }
+
+    ancestors.reserve(picks.size());
+    for(size_t ndx : picks)
+    {
+        ancestors.push_back(saved[ndx].code_);
+    }
+    return ancestors.size();
+}
+
+
+} } // ns{ oi::genprog }
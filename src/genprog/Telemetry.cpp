@@ -0,0 +1,578 @@
+/***************************************************************************/
+/**
+ * MODULE: Telemetry.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "genprog/EvoStats.hpp"
+#include "genprog/Individual.hpp"
+#include "genprog/MemStats.hpp"
+#include "genprog/Telemetry.hpp"
+
+#ifndef SHAREDSTATEDIR
+#  define SHAREDSTATEDIR "."
+#endif
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+
+/***************************************************************************/
+/* CONSTANTS                                                               */
+/***************************************************************************/
+static const char *PHASE_NAMES[] = { "selection", "reproduction", "mutation", "evaluation" };
+
+
+/***************************************************************************/
+/* STATIC DATA                                                             */
+/***************************************************************************/
+atomic<Telemetry*> Telemetry::ActiveTelemetry(nullptr);
+atomic<bool>       Telemetry::PerfEnabled(false);
+
+static thread_local Telemetry::PhaseTimer *RunningTimer = nullptr;     ///< Innermost timer on this thread
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// PhaseTimer:
+// --------------------------------------------------------------------------
+/**
+ * Starts timing a phase, if a Telemetry is active
+ *
+ * @param phase     The engine phase for this scope
+ */
+// --------------------------------------------------------------------------
+Telemetry::PhaseTimer::PhaseTimer(Phase phase)
+  : telemetry_(Telemetry::getActive()),
+    phase_    (phase),
+    parent_   (nullptr),
+    wallStart_(0),
+    cpuStart_ (0),
+    childWall_(0),
+    childCPU_ (0),
+    isPerf_   (false),
+    perfStart_(),
+    childPerf_()
+{
+    if(telemetry_)
+    {
+        parent_       = RunningTimer;
+        RunningTimer  = this;
+        isPerf_       = isPerf();
+        if(isPerf_)
+        {
+            perfStart_ = util::PerfCounters::forThisThread().read();
+        }
+        wallStart_    = nowNs(CLOCK_MONOTONIC);
+        cpuStart_     = nowNs(CLOCK_THREAD_CPUTIME_ID);
+    }
+}
+
+
+// --------------------------------------------------------------------------
+// ~PhaseTimer:
+// --------------------------------------------------------------------------
+/**
+ * Adds the scope's time, less any nested timers, to its phase
+ */
+// --------------------------------------------------------------------------
+Telemetry::PhaseTimer::~PhaseTimer()
+{
+    if(telemetry_)
+    {
+        int64_t wall = nowNs(CLOCK_MONOTONIC)          - wallStart_;
+        int64_t cpu  = nowNs(CLOCK_THREAD_CPUTIME_ID)  - cpuStart_;
+
+        telemetry_->phaseWall_[phase_].fetch_add(wall - childWall_, memory_order_relaxed);
+        telemetry_->phaseCPU_[phase_].fetch_add(cpu - childCPU_,    memory_order_relaxed);
+
+        util::PerfCounters::Sample perf = { };
+
+        if(isPerf_)
+        {
+            perf  = util::PerfCounters::forThisThread().read();
+            perf -= perfStart_;
+
+            for(int e = 0; e < util::PerfCounters::NUM_EVENTS; ++e)
+            {
+                telemetry_->phasePerf_[phase_][e].fetch_add(perf.counts_[e] - childPerf_.counts_[e],
+                                                            memory_order_relaxed);
+            }
+        }
+
+        RunningTimer = parent_;
+        if(parent_)
+        {
+            parent_->childWall_ += wall;
+            parent_->childCPU_  += cpu;
+            parent_->childPerf_ += perf;
+        }
+    }
+}
+
+
+// --------------------------------------------------------------------------
+// Active:
+// --------------------------------------------------------------------------
+/**
+ * Activates a Telemetry for the process
+ *
+ * @param telemetry The job's telemetry
+ */
+// --------------------------------------------------------------------------
+Telemetry::Active::Active(Telemetry& telemetry)
+  : previous_(ActiveTelemetry.exchange(&telemetry))
+{ }
+
+
+// --------------------------------------------------------------------------
+// ~Active:
+// --------------------------------------------------------------------------
+/**
+ * Puts back whichever Telemetry (if any) was active before
+ */
+// --------------------------------------------------------------------------
+Telemetry::Active::~Active()
+{
+    ActiveTelemetry.store(previous_);
+}
+
+
+// --------------------------------------------------------------------------
+// Telemetry:
+// --------------------------------------------------------------------------
+/**
+ * Constructor
+ *
+ * @param jobName   The job (world) name, e.g., "SPY.close.5"
+ * @param csvPath   File for per-generation CSV rows ("" for none)
+ */
+// --------------------------------------------------------------------------
+Telemetry::Telemetry(const string& jobName,
+                     const string& csvPath)
+  : jobName_     (jobName),
+    promPath_    (pathFor(jobName)),
+    genStart_    (nowNs(CLOCK_MONOTONIC)),
+    evalsAtStart_(EvoStats::snapshot().evaluations_),
+    last_        ()
+{
+    for(int p = 0; p < NUM_PHASES; ++p)
+    {
+        phaseWall_[p] = 0;
+        phaseCPU_[p]  = 0;
+        totalWall_[p] = 0.0;
+        totalCPU_[p]  = 0.0;
+
+        for(auto& count : phasePerf_[p])
+        {
+            count = 0;
+        }
+    }
+
+    if(!csvPath.empty())
+    {
+        csv_.open(csvPath.c_str());
+        if(!csv_.good())
+        {
+            throw system_error(errno, generic_category(), "Cannot create " + csvPath);
+        }
+
+        csv_ << "generation,wall_secs";
+        for(auto name : PHASE_NAMES)    csv_ << ',' << name << "_wall";
+        for(auto name : PHASE_NAMES)    csv_ << ',' << name << "_cpu";
+        csv_ << ",evaluations,evals_per_sec,size_mean,size_max";
+        for(int b = 0; b < NUM_SIZE_BUCKETS; ++b)
+        {
+            csv_ << ",size_le_" << ((b < NUM_SIZE_BUCKETS - 1) ? to_string(1 << b) : string("inf"));
+        }
+        csv_ << ",gauges" << endl;
+    }
+}
+
+
+// --------------------------------------------------------------------------
+// ~Telemetry:
+// --------------------------------------------------------------------------
+/**
+ * Destructor: removes the job's metrics file
+ */
+// --------------------------------------------------------------------------
+Telemetry::~Telemetry()
+{
+    if(!promPath_.empty())
+    {
+        remove(promPath_.c_str());
+    }
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// pathFor:
+// --------------------------------------------------------------------------
+/**
+ * Returns the standard Prometheus metrics file for a job
+ *
+ * @param jobName   The job (world) name, e.g., "SPY.close.5"
+ *
+ * @return          /path/to/metrics/jobName.prom
+ */
+// --------------------------------------------------------------------------
+string Telemetry::pathFor(const string& jobName)
+{
+    return SHAREDSTATEDIR "/metrics/" + jobName + ".prom";
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getPhaseName:
+// --------------------------------------------------------------------------
+/**
+ * Returns the name of a phase, for logs and JSON
+ */
+// --------------------------------------------------------------------------
+const char* Telemetry::getPhaseName(Phase phase)
+{
+    return PHASE_NAMES[phase];
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// setPerf:
+// --------------------------------------------------------------------------
+/**
+ * Turns hardware counters for the phase timers on or off
+ *
+ * @param yesNo     true to take cycles, instructions, LLC and branch
+ *                  misses by phase
+ */
+// --------------------------------------------------------------------------
+void Telemetry::setPerf(bool yesNo)
+{
+    PerfEnabled.store(yesNo);
+}
+
+
+// --------------------------------------------------------------------------
+// getPhaseCPUSecs:
+// --------------------------------------------------------------------------
+/**
+ * Returns the CPU time a phase has taken over the generations so far
+ */
+// --------------------------------------------------------------------------
+double Telemetry::getPhaseCPUSecs(Phase phase) const
+{
+    return totalCPU_[phase];
+}
+
+
+// --------------------------------------------------------------------------
+// getPhasePerf:
+// --------------------------------------------------------------------------
+/**
+ * Returns the hardware counts for a phase over the job so far (all zero
+ * unless setPerf() is on and perf events are available)
+ */
+// --------------------------------------------------------------------------
+util::PerfCounters::Sample Telemetry::getPhasePerf(Phase phase) const
+{
+    util::PerfCounters::Sample perf = { };
+
+    for(int e = 0; e < util::PerfCounters::NUM_EVENTS; ++e)
+    {
+        perf.counts_[e] = phasePerf_[phase][e].load(memory_order_relaxed);
+    }
+    return perf;
+}
+
+
+// --------------------------------------------------------------------------
+// setGauge:
+// --------------------------------------------------------------------------
+/**
+ * Records an extra metric for the current generation, such as allocations
+ * or a cache hit rate.  The value is kept until it is set again.
+ *
+ * @param name      Metric name (Prometheus style: lower_case_with_units)
+ * @param value     Current value
+ */
+// --------------------------------------------------------------------------
+void Telemetry::setGauge(const string& name, double value)
+{
+    gauges_[name] = value;
+}
+
+
+// --------------------------------------------------------------------------
+// endGeneration:
+// --------------------------------------------------------------------------
+/**
+ * Closes out a generation: takes the phase times and tree sizes, exports
+ * the row, and starts timing the next generation.  The World calls this once
+ * per generation from the thread running evolve().
+ *
+ * @param population    The population as it stands at the end of the
+ *                      generation
+ */
+// --------------------------------------------------------------------------
+void Telemetry::endGeneration(const vector<unique_ptr<Individual>>& population)
+{
+    int64_t  now    = nowNs(CLOCK_MONOTONIC);
+    u_long   evals  = EvoStats::snapshot().evaluations_;
+    Row      row    = { };
+    u_long   nodes  = 0;
+    u_long   count  = 0;
+
+    row.generation_  = last_.generation_ + 1;
+    row.wallSecs_    = (now - genStart_) / 1e9;
+    row.evaluations_ = evals - evalsAtStart_;
+
+    for(int p = 0; p < NUM_PHASES; ++p)
+    {
+        row.phaseWall_[p] = phaseWall_[p].exchange(0) / 1e9;
+        row.phaseCPU_[p]  = phaseCPU_[p].exchange(0)  / 1e9;
+        totalWall_[p]    += row.phaseWall_[p];
+        totalCPU_[p]     += row.phaseCPU_[p];
+    }
+
+    for(auto& guy : population)
+    {
+        if(guy)
+        {
+            u_int size   = guy->getChromoNodeCnt();
+            int   bucket = 0;
+
+            while((bucket < NUM_SIZE_BUCKETS - 1) && (size > (1U << bucket)))
+            {
+                ++bucket;
+            }
+            ++row.sizeHist_[bucket];
+            row.maxSize_ = max(row.maxSize_, size);
+            nodes       += size;
+            ++count;
+        }
+    }
+    row.meanSize_ = count ? ((double) nodes / count) : 0.0;
+
+    // Memory footprint goes along with every generation
+    setGauge("live_alleles",     MemStats::getLive(MemStats::ALLELE));
+    setGauge("live_individuals", MemStats::getLive(MemStats::INDIVIDUAL));
+    setGauge("live_bytes",       MemStats::getLiveBytes());
+    setGauge("peak_bytes",       MemStats::getPeakBytes());
+    row.gauges_   = gauges_;
+
+    last_         = row;
+    genStart_     = now;
+    evalsAtStart_ = evals;
+
+    // Metrics must never cost us the job: on trouble, stop exporting
+    if(!promPath_.empty()) try
+    {
+        writePrometheus(promPath_);
+    }
+    catch(system_error&)
+    {
+        remove(promPath_.c_str());
+        promPath_.clear();
+    }
+    if(csv_.is_open())
+    {
+        writeCSV(row);
+    }
+}
+
+
+// --------------------------------------------------------------------------
+// writePrometheus:
+// --------------------------------------------------------------------------
+/**
+ * Writes the latest generation's metrics, and the job's running phase
+ * totals, in Prometheus text format.  The file is replaced atomically so
+ * the collector never scrapes half of it.
+ *
+ * @param path      Metrics file
+ */
+// --------------------------------------------------------------------------
+void Telemetry::writePrometheus(const string& path) const
+{
+    ostringstream prom;
+    string        job     = "{sibyl_job=\"" + jobName_ + "\"";
+    string        tmpPath = path + ".tmp";
+    const Row&    row     = last_;
+
+    prom.precision(9);
+
+    prom << "# HELP sibyl_generation Generations completed\n"
+         << "# TYPE sibyl_generation gauge\n"
+         << "sibyl_generation" << job << "} " << row.generation_ << '\n'
+
+         << "# HELP sibyl_generation_wall_seconds Wall time for the last generation\n"
+         << "# TYPE sibyl_generation_wall_seconds gauge\n"
+         << "sibyl_generation_wall_seconds" << job << "} " << row.wallSecs_ << '\n'
+
+         << "# HELP sibyl_phase_wall_seconds Wall time by phase in the last generation, summed over threads\n"
+         << "# TYPE sibyl_phase_wall_seconds gauge\n";
+    for(int p = 0; p < NUM_PHASES; ++p)
+    {
+        prom << "sibyl_phase_wall_seconds" << job << ",phase=\"" << PHASE_NAMES[p] << "\"} " << row.phaseWall_[p] << '\n';
+    }
+
+    prom << "# HELP sibyl_phase_cpu_seconds CPU time by phase in the last generation\n"
+         << "# TYPE sibyl_phase_cpu_seconds gauge\n";
+    for(int p = 0; p < NUM_PHASES; ++p)
+    {
+        prom << "sibyl_phase_cpu_seconds" << job << ",phase=\"" << PHASE_NAMES[p] << "\"} " << row.phaseCPU_[p] << '\n';
+    }
+
+    prom << "# HELP sibyl_phase_cpu_seconds_total CPU time by phase for the job\n"
+         << "# TYPE sibyl_phase_cpu_seconds_total counter\n";
+    for(int p = 0; p < NUM_PHASES; ++p)
+    {
+        prom << "sibyl_phase_cpu_seconds_total" << job << ",phase=\"" << PHASE_NAMES[p] << "\"} " << totalCPU_[p] << '\n';
+    }
+
+    prom << "# HELP sibyl_evaluations Fitness evaluations in the last generation\n"
+         << "# TYPE sibyl_evaluations gauge\n"
+         << "sibyl_evaluations" << job << "} " << row.evaluations_ << '\n'
+
+         << "# HELP sibyl_evaluations_per_second Fitness evaluation rate in the last generation\n"
+         << "# TYPE sibyl_evaluations_per_second gauge\n"
+         << "sibyl_evaluations_per_second" << job << "} "
+                                           << (row.wallSecs_ > 0.0 ? (row.evaluations_ / row.wallSecs_) : 0.0) << '\n'
+
+         << "# HELP sibyl_tree_size_max Biggest tree in the population (nodes)\n"
+         << "# TYPE sibyl_tree_size_max gauge\n"
+         << "sibyl_tree_size_max" << job << "} " << row.maxSize_ << '\n'
+
+         << "# HELP sibyl_tree_size Tree sizes in the population (nodes)\n"
+         << "# TYPE sibyl_tree_size histogram\n";
+
+    u_long cumulative = 0;
+    u_long count      = 0;
+
+    for(int b = 0; b < NUM_SIZE_BUCKETS; ++b)
+    {
+        count += row.sizeHist_[b];
+    }
+    for(int b = 0; b < NUM_SIZE_BUCKETS; ++b)
+    {
+        cumulative += row.sizeHist_[b];
+        prom << "sibyl_tree_size_bucket" << job << ",le=\""
+             << ((b < NUM_SIZE_BUCKETS - 1) ? to_string(1 << b) : string("+Inf")) << "\"} " << cumulative << '\n';
+    }
+    prom << "sibyl_tree_size_sum"   << job << "} " << (row.meanSize_ * count) << '\n'
+         << "sibyl_tree_size_count" << job << "} " << count << '\n';
+
+    if(isPerf())
+    {
+        for(int e = 0; e < util::PerfCounters::NUM_EVENTS; ++e)
+        {
+            string metric = string("sibyl_phase_") + util::PerfCounters::getEventName((util::PerfCounters::Event) e)
+                                                   + "_total";
+
+            prom << "# TYPE " << metric << " counter\n";
+            for(int p = 0; p < NUM_PHASES; ++p)
+            {
+                prom << metric << job << ",phase=\"" << PHASE_NAMES[p] << "\"} "
+                     << phasePerf_[p][e].load(memory_order_relaxed) << '\n';
+            }
+        }
+    }
+
+    for(auto& gauge : row.gauges_)
+    {
+        prom << "# TYPE sibyl_" << gauge.first << " gauge\n"
+             << "sibyl_" << gauge.first << job << "} " << gauge.second << '\n';
+    }
+
+    // Swap in the new file
+    {
+        ofstream file(tmpPath.c_str());
+
+        file << prom.str();
+        if(!file.good())
+        {
+            throw system_error(errno, generic_category(), "Cannot write " + tmpPath);
+        }
+    }
+    if(rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        int err = errno;
+
+        remove(tmpPath.c_str());
+        throw system_error(err, generic_category(), "Cannot replace " + path);
+    }
+}
+
+
+/***************************************************************************/
+/* PUBLIC FRIENDS                                                          */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// operator<<:
+// --------------------------------------------------------------------------
+/**
+ * Writes the job's CPU time by phase, e.g., for the log after evolve()
+ */
+// --------------------------------------------------------------------------
+ostream& operator <<(ostream& out, const Telemetry& rhs)
+{
+    out << rhs.last_.generation_ << " gens";
+    for(int p = 0; p < Telemetry::NUM_PHASES; ++p)
+    {
+        out << ", " << PHASE_NAMES[p] << ' ' << rhs.totalCPU_[p] << 's';
+    }
+    return out;
+}
+
+
+/***************************************************************************/
+/* PRIVATE CLASS METHODS                                                   */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// writeCSV:
+// --------------------------------------------------------------------------
+/**
+ * Appends a generation's row to the CSV file.  Gauges go in the last field
+ * as name=value pairs, since they vary by engine.
+ */
+// --------------------------------------------------------------------------
+void Telemetry::writeCSV(const Row& row)
+{
+    csv_ << row.generation_ << ',' << row.wallSecs_;
+    for(auto secs : row.phaseWall_)     csv_ << ',' << secs;
+    for(auto secs : row.phaseCPU_)      csv_ << ',' << secs;
+    csv_ << ',' << row.evaluations_
+         << ',' << (row.wallSecs_ > 0.0 ? (row.evaluations_ / row.wallSecs_) : 0.0)
+         << ',' << row.meanSize_
+         << ',' << row.maxSize_;
+    for(auto cnt : row.sizeHist_)       csv_ << ',' << cnt;
+
+    csv_ << ',';
+    for(auto& gauge : row.gauges_)
+    {
+        csv_ << ((&gauge == &*row.gauges_.begin()) ? "" : ";") << gauge.first << '=' << gauge.second;
+    }
+    csv_ << endl;
+}
+
+
+} } // ns{ oi::genprog }
@@ -0,0 +1,430 @@
+/***************************************************************************/
+/**
+ * MODULE: Tuning.cpp
+ *
+ * @author Dennis Drown
+ * @date   18 Oct 2026
+ *
+ * @copyright 2026 Dennis Drown and Ostrich Ideas
+ */
+/***************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/thread.hpp>
+
+#include "genprog/ColumnWindow.hpp"
+#include "genprog/Tuning.hpp"
+#include "util/Logger.hpp"
+
+#ifndef SHAREDSTATEDIR
+#  define SHAREDSTATEDIR "."
+#endif
+
+namespace oi { namespace genprog {
+
+using namespace std;
+
+namespace po = boost::program_options;
+
+
+/***************************************************************************/
+/* CONSTANTS                                                               */
+/***************************************************************************/
+static const u_int  CALIB_ATTRS     = 8;        ///< Synthetic attributes (the last is the target)
+static const u_int  CALIB_ROWS      = 8192;     ///< Synthetic days of data
+static const u_int  CALIB_WIN       = 30;       ///< Sliding window for the synthetic data
+static const u_int  CALIB_LEAVES    = 8;        ///< Lookups in the stand-in tree
+static const u_int  CALIB_NODES     = (2 * CALIB_LEAVES) - 1;  ///< All nodes in the stand-in tree
+static const u_int  MIN_BLOCK       = 32;       ///< Smallest block size we try
+static const u_int  MAX_BLOCK       = 4096;     ///< Biggest block size we try
+static const int    BLOCK_MSECS     = 50;       ///< Time per block size trial
+static const int    THREAD_MSECS    = 100;      ///< Time per thread count trial
+static const double THREAD_SLACK    = 0.05;     ///< Take fewer threads when within this of the best
+
+
+/***************************************************************************/
+/* STATIC DATA                                                             */
+/***************************************************************************/
+Tuning Tuning::Current;
+
+static volatile Real Sink;                      ///< Keeps the optimizer honest
+
+
+/***************************************************************************/
+/* PRIVATE METHODS                                                         */
+/***************************************************************************/
+
+// ---------------------------------------------------------------- STATIC --
+// evalBlock:
+// --------------------------------------------------------------------------
+/**
+ * Stands in for batched evaluation of one tree over a block of days: eight
+ * lookups feed a balanced tree of seven arithmetic nodes, and each node
+ * writes a block-sized buffer, as the batched tree walk does.  The block
+ * size decides whether those buffers stay in the caches.
+ *
+ * @param win       Synthetic data window
+ * @param firstDay  First day of the block (relative to the window's range)
+ * @param numDays   Days in the block
+ * @param bufs      Node buffers: (CALIB_LEAVES - 1) blocks
+ *
+ * @return          Sum of the root's values (so nothing gets optimized out)
+ */
+// --------------------------------------------------------------------------
+static Real evalBlock(const ColumnWindow& win,
+                      u_int               firstDay,
+                      u_int               numDays,
+                      vector<Real>&       bufs)
+{
+    const Real *in[CALIB_LEAVES];
+
+    for(u_int leaf = 0; leaf < CALIB_LEAVES; ++leaf)
+    {
+        in[leaf] = win.stream(leaf % win.getNumAttrs(), (leaf * 7) % win.getWindowLen()) + firstDay;
+    }
+
+    // Combine pairs level by level: +, -, *, protected / by node
+    u_int width = CALIB_LEAVES;
+    Real *out   = bufs.data();
+
+    while(width > 1)
+    {
+        for(u_int n = 0; n < width / 2; ++n, out += numDays)
+        {
+            const Real *x = in[2 * n];
+            const Real *y = in[2 * n + 1];
+
+            switch(n % 4)
+            {
+                case 0: for(u_int d = 0; d < numDays; ++d) out[d] = x[d] + y[d];  break;
+                case 1: for(u_int d = 0; d < numDays; ++d) out[d] = x[d] - y[d];  break;
+                case 2: for(u_int d = 0; d < numDays; ++d) out[d] = x[d] * y[d];  break;
+                case 3: for(u_int d = 0; d < numDays; ++d) out[d] = (y[d] != 0.0) ? (x[d] / y[d]) : 1.0;  break;
+            }
+            in[n] = out;
+        }
+        width /= 2;
+    }
+
+    Real sum = 0.0;
+
+    for(u_int d = 0; d < numDays; ++d)
+    {
+        sum += in[0][d];
+    }
+    return sum;
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// measure:
+// --------------------------------------------------------------------------
+/**
+ * Runs the stand-in evaluation on a number of threads for a while
+ *
+ * @param cols      Synthetic attribute columns
+ * @param numThreads Evaluation threads
+ * @param blockSize Days per block
+ * @param msecs     How long to run
+ *
+ * @return          Nodes evaluated per second, over all threads
+ */
+// --------------------------------------------------------------------------
+static double measure(const vector<const Real*>& cols,
+                      u_int                      numThreads,
+                      u_int                      blockSize,
+                      int                        msecs)
+{
+    using Clock = chrono::steady_clock;
+
+    atomic<bool>        go(false);
+    atomic<u_long>      nodes(0);
+    boost::thread_group workers;
+    Clock::time_point   start;
+    Clock::time_point   stop;
+
+    for(u_int t = 0; t < numThreads; ++t)
+    {
+        workers.create_thread([&, t]()
+            {
+                ColumnWindow win(cols, CALIB_ROWS, CALIB_WIN, CALIB_ATTRS - 1);
+                vector<Real> bufs((CALIB_LEAVES - 1) * blockSize);
+                u_int        numDays = win.getNumDays() - (win.getNumDays() % blockSize);
+                u_int        day     = (t * blockSize) % numDays;
+                u_long       done    = 0;
+                Real         sink    = 0.0;
+
+                while(!go.load(memory_order_acquire))
+                {
+                    boost::this_thread::yield();
+                }
+                while(Clock::now() < stop)
+                {
+                    sink += evalBlock(win, day, blockSize, bufs);
+                    done += CALIB_NODES * blockSize;
+                    day   = (day + blockSize) % numDays;
+                }
+                nodes.fetch_add(done, memory_order_relaxed);
+                Sink = sink;
+            });
+    }
+
+    start = Clock::now();
+    stop  = start + chrono::milliseconds(msecs);
+    go.store(true, memory_order_release);
+    workers.join_all();
+
+    return nodes.load() / chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+/***************************************************************************/
+/* PUBLIC CLASS METHODS                                                    */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// Tuning:
+// --------------------------------------------------------------------------
+/**
+ * Constructor
+ *
+ * @param threads   Evaluation threads (0 means one per core)
+ * @param blockSize Evaluation days per batch
+ * @param islands   Sub-populations
+ */
+// --------------------------------------------------------------------------
+Tuning::Tuning(u_int threads,
+               u_int blockSize,
+               u_int islands)
+  : threads_  (threads ? threads : max(1U, boost::thread::hardware_concurrency())),
+    blockSize_(max(1U, blockSize)),
+    islands_  (max(1U, islands)),
+    simd_     (util::HardwareProbe::getSIMDName(util::HardwareProbe::getSIMD()))
+{ }
+
+
+// ---------------------------------------------------------------- STATIC --
+// get:
+// --------------------------------------------------------------------------
+/**
+ * Returns this node's tuning: from the tuning file (or config) if there is
+ * one, otherwise the defaults
+ */
+// --------------------------------------------------------------------------
+const Tuning& Tuning::get()
+{
+    return Current;
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// pathFor:
+// --------------------------------------------------------------------------
+/**
+ * Returns the tuning file for this node.  The state directory may be shared
+ * across the cluster, so each host gets its own file.
+ *
+ * @return          /path/to/tuning/hostname.conf
+ */
+// --------------------------------------------------------------------------
+string Tuning::pathFor()
+{
+    char hostName[64];
+
+    gethostname(hostName, sizeof(hostName));
+    hostName[sizeof(hostName)-1] = '\0';
+
+    return SHAREDSTATEDIR "/tuning/" + string(hostName) + ".conf";
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// calibrate:
+// --------------------------------------------------------------------------
+/**
+ * Times a stand-in for the evaluation engine on synthetic data to choose
+ * this node's settings.  This takes a second or two.
+ *
+ *  - block size: the fastest single-thread block, from MIN_BLOCK to MAX_BLOCK
+ *  - threads:    the fewest threads within THREAD_SLACK of the best rate
+ *  - islands:    one per NUMA node, but no more than there are threads
+ *
+ * @param hw        What the hardware probe found
+ * @param out       Output stream for logging
+ *
+ * @return          The tuning.  (It doesn't become current until the
+ *                  tuning file is loaded.)
+ */
+// --------------------------------------------------------------------------
+Tuning Tuning::calibrate(const util::HardwareProbe::Info& hw, ostream& out)
+{
+    // Random walks, from our own rand48 stream so the job seeds aren't touched
+    unsigned short      xsubi[3] = { 0x5EED, 0x1234, 0xABCD };
+    vector<vector<Real>> data(CALIB_ATTRS, vector<Real>(CALIB_ROWS));
+    vector<const Real*>  cols;
+
+    for(auto& col : data)
+    {
+        Real price = 100.0;
+
+        for(auto& x : col)
+        {
+            price += erand48(xsubi) - 0.5;
+            x      = price;
+        }
+        cols.push_back(col.data());
+    }
+
+    // Block size first, on one thread
+    u_int  bestBlock = MIN_BLOCK;
+    double bestRate  = 0.0;
+
+    for(u_int block = MIN_BLOCK; block <= MAX_BLOCK; block *= 2)
+    {
+        double rate = measure(cols, 1, block, BLOCK_MSECS);
+
+        out << LOG_INFO << "Tune block " << block << ": " << (rate / 1e6) << " Mnodes/s" << endl;
+        if(rate > bestRate)
+        {
+            bestRate  = rate;
+            bestBlock = block;
+        }
+    }
+
+    // Then threads, with that block size
+    vector<u_int>  counts;
+    vector<double> rates;
+
+    for(u_int n = 1; n < (u_int) hw.cores_; n *= 2)
+    {
+        counts.push_back(n);
+    }
+    counts.push_back(hw.cores_);
+
+    for(u_int n : counts)
+    {
+        rates.push_back(measure(cols, n, bestBlock, THREAD_MSECS));
+        out << LOG_INFO << "Tune threads " << n << ": " << (rates.back() / 1e6) << " Mnodes/s" << endl;
+    }
+
+    double topRate = *max_element(rates.begin(), rates.end());
+    u_int  threads = counts.back();
+
+    for(size_t i = 0; i < counts.size(); ++i)
+    {
+        if(rates[i] >= (1.0 - THREAD_SLACK) * topRate)
+        {
+            threads = counts[i];
+            break;
+        }
+    }
+
+    Tuning tuning(threads, bestBlock, min<u_int>(hw.numaNodes_, threads));
+
+    tuning.simd_ = util::HardwareProbe::getSIMDName(hw.simd_);
+    return tuning;
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// getOptionsDescr:
+// --------------------------------------------------------------------------
+/**
+ * Returns the [tuning] options for the config and tuning files
+ */
+// --------------------------------------------------------------------------
+po::options_description Tuning::getOptionsDescr()
+{
+    po::options_description descr("Tuning");
+
+    descr.add_options()
+            ("tuning.threads",    po::value<u_int>(),  "Evaluation threads")
+            ("tuning.block-size", po::value<u_int>(),  "Evaluation days per batch")
+            ("tuning.islands",    po::value<u_int>(),  "Sub-populations")
+            ("tuning.simd",       po::value<string>(), "SIMD level the node was tuned with");
+
+    return descr;
+}
+
+
+// ---------------------------------------------------------------- STATIC --
+// setOptions:
+// --------------------------------------------------------------------------
+/**
+ * Makes the [tuning] options current.  Anything not set keeps its default.
+ *
+ * @param cfg       Options from the config and tuning files
+ */
+// --------------------------------------------------------------------------
+void Tuning::setOptions(const po::variables_map& cfg)
+{
+    if(cfg.count("tuning.threads"))     Current.threads_   = max(1U, cfg["tuning.threads"].as<u_int>());
+    if(cfg.count("tuning.block-size"))  Current.blockSize_ = max(1U, cfg["tuning.block-size"].as<u_int>());
+    if(cfg.count("tuning.islands"))     Current.islands_   = max(1U, cfg["tuning.islands"].as<u_int>());
+    if(cfg.count("tuning.simd"))        Current.simd_      = cfg["tuning.simd"].as<string>();
+}
+
+
+// --------------------------------------------------------------------------
+// save:
+// --------------------------------------------------------------------------
+/**
+ * Writes the tuning as a [tuning] section.  The file is replaced atomically.
+ *
+ * @param path      Tuning file
+ *
+ * @return          true if the file was written
+ */
+// --------------------------------------------------------------------------
+bool Tuning::save(const string& path) const
+{
+    string   tmpPath = path + ".tmp";
+    ofstream file(tmpPath.c_str(), ios::trunc);
+
+    file << "# Written by sibyl --system; edit sibyl.conf (or --set) to override\n"
+         << "[tuning]\n"
+         << "threads    = " << threads_   << '\n'
+         << "block-size = " << blockSize_ << '\n'
+         << "islands    = " << islands_   << '\n'
+         << "simd       = " << simd_      << '\n';
+    file.close();
+
+    if(!file.good() || (rename(tmpPath.c_str(), path.c_str()) != 0))
+    {
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+
+/***************************************************************************/
+/* PUBLIC FRIENDS                                                          */
+/***************************************************************************/
+
+// --------------------------------------------------------------------------
+// operator<<:
+// --------------------------------------------------------------------------
+/**
+ * Writes the tuning as a one-line summary
+ */
+// --------------------------------------------------------------------------
+ostream& operator <<(ostream& out, const Tuning& rhs)
+{
+    return out << rhs.threads_   << " threads, "
+               << rhs.blockSize_ << "-day blocks, "
+               << rhs.islands_   << " islands, "
+               << rhs.simd_;
+}
+
+
+} } // ns{ oi::genprog }
@@ -10,7 +10,13 @@
 #include "config.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cfloat>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -20,9 +26,13 @@
 
 #include <fcntl.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 
 #include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 #include <boost/serialization/string.hpp>
@@ -33,14 +43,26 @@
 #include "oi-conf.hpp"
 #include "oi-cluster.hpp"
 #include "oi-string.hpp"
+#include "genprog/EvoStats.hpp"
+#include "genprog/GeneTree.hpp"
+#include "genprog/MemStats.hpp"
+#include "genprog/OpKernels.hpp"
+#include "genprog/Telemetry.hpp"
 #include "genprog/test.hpp"
+#include "genprog/Tuning.hpp"
 #include "market/Delphi.hpp"
+#include "market/DelphiFile.hpp"
+#include "market/DelphiWriter.hpp"
 #include "market/PriceDataPack.hpp"
 #include "market/PriceWorld.hpp"
 #include "market/Prognosticator.hpp"
 #include "market/SecurityPack.hpp"
+#include "util/AsyncLog.hpp"
 #include "util/Logger.hpp"
 #include "util/HumanClock.hpp"
+#include "util/HardwareProbe.hpp"
+#include "util/JsonWriter.hpp"
+#include "util/PacingGovernor.hpp"
 #include "util/CPUClock.hpp"
 
 #if ENABLE_CUDA
@@ -177,6 +199,26 @@ struct ToDoQueue
 };  // ToDoQueue
 
 
+/**
+ * Everything a node needs to work a ProgJob for the current security.
+ *
+ * @tparam DB   Delphi backend: Delphi or DelphiFile
+ */
+template<class DB>
+struct JobEnv
+{
+    const vector<ProgJob>&  jobs_;          ///< Job list (per security)
+    HumanClock&             scheduler_;     ///< Daily run window
+    const PacingGovernor&   governor_;      ///< Pacing for non-eager runs
+    DB                     *db_;            ///< Delphi connection for this process
+    DelphiWriter<DB>       *writer_;        ///< Background Delphi writes for this process
+    PriceDataPack&          priceData_;     ///< Price data for current security (read-only)
+    MPI_Communicator&       mpiComm_;       ///< MPI world
+    bool                    isDiscrete_;    ///< Do not save models in Delphi
+    bool                    isEager_;       ///< Skip naps and cool-downs
+};
+
+
 // --------------------------------------------------------------------------
 // Module Global Data:
 // --------------------------------------------------------------------------
@@ -190,11 +232,24 @@ static string CFG_INSERT_BEST_GENS("");                 ///< CLI: CSV of generat
                                                         ///<      best models
 static string CFG_SECURITIES("*");                      ///< CLI: CSV of securities (stock
                                                         ///<      symbols) to run
+static string CFG_DELPHI_DIR("");                       ///< CLI: Directory for file-backed
+                                                        ///<      Delphi stand-in ("" means
+                                                        ///<      use the Delphi database)
+static string CFG_BENCH_JSON("");                       ///< CLI: File for --bench results
+                                                        ///<      ("" means the log)
+static string CFG_TELEMETRY_CSV("");                    ///< CLI: Directory for per-job
+                                                        ///<      generation CSVs ("" for
+                                                        ///<      none)
+static string CFG_SIMD("");                             ///< CLI: Highest SIMD level for the
+                                                        ///<      GP kernels ("" for the
+                                                        ///<      best the CPU has)
 static string CFG_SEEDS_48("");                         ///< CLI: CSV of three unsigned
                                                         ///<      shorts for RNG, or ""
                                                         ///<      "" for random seeds
 static int    CFG_RUN_TEST      = -1;                   ///< CLI: Run this test number and
                                                         ///<      exit (-1 means none)
+static int    CFG_BENCH_RUNS    = 0;                    ///< CLI: Seeded runs of the test
+                                                        ///<      to benchmark (0 = none)
 static int    CFG_MASTER_NODE   = -1;                   ///< CLI: Node that directs the
                                                         ///<      others. -1 means last one
                                                         ///<      in machines file
@@ -205,6 +260,19 @@ static int    CFG_DAYS_TO_PULL  = (8 * 30);             ///< CLI: Number of days
 static int    CFG_DAYS_IN_WIN   = 90;                   ///< CLI: Number of day in the
                                                         ///<      sliding compute window
                                                         ///<      (for creating model)
+static int    CFG_LONER_JOBS    = 1;                    ///< CLI: Number of jobs to run
+                                                        ///<      concurrently (as a crew
+                                                        ///<      of forked workers) when
+                                                        ///<      we are the only node
+static double CFG_BENCH_TARGET  = DBL_MAX;              ///< CLI: Fitness that solves a
+                                                        ///<      --bench scenario
+static double CFG_PACE_LOAD     = 1.0;                  ///< CLI: Highest load average per
+                                                        ///<      CPU (from other work) before
+                                                        ///<      pausing a job
+static double CFG_PACE_TEMP     = 80.0;                 ///< CLI: Highest CPU temperature
+                                                        ///<      (Celsius) before pausing
+static bool   CFG_PERF          = false;                ///< CLI: Whether to take hardware
+                                                        ///<      counters by GP phase
 static bool   CFG_USE_XSEC_DIA  = false;                ///< CLI: Whether to use DIA
                                                         ///<      (Dow Jones) ETF as an
                                                         ///<      extra security attribute
@@ -217,8 +285,15 @@ static bool   CFG_MIRROR_GPU    = false;                ///< CLI: Whether to use
                                                         ///<      results.
 #endif
 static bool   IsLoner           = false;                ///< Are we the only node running?
+static int    LonerWorker       = -1;                   ///< Our number in the loner crew
+                                                        ///<      (-1 if there is no crew)
+static string DelphiSource;                             ///< DB host (or directory for the
+                                                        ///<      file-backed stand-in)
 
 static ToDoQueue *ToDos = NULL;         ///< List of jobs to process. Only used on MPI root
+static AsyncLog  *ALog  = NULL;         ///< Asynchronous front end for the log (from main)
+
+static atomic<uint64_t> *LonerClaims = NULL;    ///< Job claims, shared by the loner crew
 
 /**
  * Delphi model version:
@@ -319,6 +394,16 @@ static void initRand48(ostream& out)
     seed48(seeds);
     out << LOG_NOTICE << "RNG { " << seeds[0] << "," << seeds[1] << "," << seeds[2] << " }" << endl;
 
+    // The loner crew all start from the same seeds, so each worker moves on
+    // to a stream of its own (and --seeds48 runs still repeat)
+    for(int w = 0; w < LonerWorker; ++w)
+    {
+        seeds[0] = (unsigned short) lrand48();
+        seeds[1] = (unsigned short) lrand48();
+        seeds[2] = (unsigned short) lrand48();
+        seed48(seeds);
+    }
+
     // An afterthought...
     //
     // HumanClock still uses random() for non-critical timing
@@ -349,17 +434,25 @@ static void doCLIOptions(int argc, char **argv, ConfInfo& descr, ConfMap& cfg)
     using namespace ini;
 
     descr.add_options()
+            ("bench",            value<int>(),    "Benchmark the --test scenario over this many seeded runs,"
+                                                  " reporting JSON")
+            ("bench-json",       value<string>(), "Write --bench results to this file instead of the log")
+            ("bench-target",     value<double>(), "Fitness that counts as solving a --bench scenario")
             ("config,c",         value<string>(), "Use this configuration file (default: " CFGDEF_CFG_FILEPATH ")")
             ("days-to-pull",     value<int>(),    "Days (records) to pull from the delphi DB per run")
             ("days-in-win",      value<int>(),    "Days in sliding GP compute window")
             ("db-host",          value<string>(), "Database server with Delphi")
             ("db-user",          value<string>(), "Database user for Delphi")
+            ("delphi-dir",       value<string>(), "Use files in this directory instead of the Delphi database"
+                                                  " (offline and benchmark runs)")
             ("discrete,d",                        "Do not save generated models in delphi")
-            ("eager,E",                           "Skip cool-down break between partial runs")
+            ("eager,E",                           "Skip pacing checks between jobs")
             ("help,?",                            "Display this handy help text")
             ("insert-best-gens", value<string>(), "CSV list of generations when Sibyl should insert previous"
                                                   " \"best\" models")
             ("log-stub",         value<string>(), "Logs output to /path/log-stub.YYYYMMDD.log")
+            ("loner-jobs",       value<int>(),    "Number of jobs to run concurrently, as forked workers, when"
+                                                  " Sibyl is the only node running (default: 1)")
             ("master-node",      value<int>(),    "MPI node number responsible for managing the others (does"
                                                   " no real work)."
                                                   " Defaults to -1, which means the last node")
@@ -368,12 +461,25 @@ static void doCLIOptions(int argc, char **argv, ConfInfo& descr, ConfMap& cfg)
             ("mirror-gpu",                        "Do work on CPU and GPU to compare (debug option)")
 #endif
             ("once,1",                            "Run through securities once and quit")
+            ("pace-load",        value<double>(), "Pause before a job while the load average per CPU, not"
+                                                  " counting Sibyl's own, is above this (default: 1.0)")
+            ("pace-temp",        value<double>(), "Pause before a job while the CPU is hotter than this"
+                                                  " (Celsius, default: 80)")
+            ("perf",                              "Sample hardware counters (cycles, instructions, cache and"
+                                                  " branch misses) for each evolution phase")
             ("prog-jobs",        value<string>(), "Prognosticator job list: low:30,high:30,close:30")
             ("moving-avg",       value<string>(), "Moving average(s) for an attribute: close:50,200")
             ("seeds48",          value<string>(), "Seed array for rand48 RNG, example: \"1,2,3\"")
             ("securities",       value<string>(), "CSV list of stock symbols to run, or * for all active"
                                                   " securities")
+            ("set",              value<vector<string>>()->composing(),
+                                                  "Override a config file option: name=value (e.g., to vary"
+                                                  " population, generations or threads for --bench)")
+            ("simd",             value<string>(), "Highest SIMD level for the GP kernels: none, sse2, avx2 or"
+                                                  " avx512 (default: the best this CPU has)")
             ("system",                            "Show info about footprint on this machine")
+            ("telemetry-csv",    value<string>(), "Write per-generation performance metrics for each job to"
+                                                  " a CSV file in this directory")
             ("test",             value<int>(),    "Run test number")
             ("use-xsec-dia",                      "Use closing prices for DIA (Dow Jones) ETF as an extra"
                                                   " attribute [IGNORED]")
@@ -425,12 +531,33 @@ static void doCfgOptions(ini::options_description& descr,
         // Collect options descriptions from classes that want them
         descr.add(HumanClock::getOptionsDescr());
         descr.add(PriceWorld::getOptionsDescr());
+        descr.add(Tuning::getOptionsDescr());
+
+        // Overrides from --set go in first, so they beat the file
+        if(cfg.count("set"))
+        {
+            stringstream overrides;
 
+            for(auto& line : cfg["set"].as<vector<string>>())
+            {
+                overrides << line << '\n';
+            }
+            store(parse_config_file(overrides, descr, allowUnregistered), cfg);
+        }
         store(parse_config_file(in, descr, allowUnregistered), cfg);
+
+        // The node's tuning file (from --system) goes in last, so the config file beats it
+        ifstream tuning(Tuning::pathFor().c_str());
+
+        if(tuning.good())
+        {
+            store(parse_config_file(tuning, descr, allowUnregistered), cfg);
+        }
         notify(cfg);
 
         // Now let those same classes know their options
         PriceWorld::setOptions(cfg);
+        Tuning::setOptions(cfg);
 
         in.close();
     }
@@ -445,7 +572,8 @@ static void doCfgOptions(ini::options_description& descr,
 // --------------------------------------------------------------------------
 /**
  * Prints information about the machine Sibyl is running on and her footprint
- * on it.
+ * on it, then calibrates the evaluation engine for this machine and saves
+ * the result as the node's tuning file (used from the next start on).
  *
  * @param out   Output stream for logging
  */
@@ -454,7 +582,17 @@ static void showSystem(ostream& out)
 {
     using namespace boost;
 
+    auto hw = HardwareProbe::probe();
+
     out << LOG_INFO << "CPU cores      : " << thread::hardware_concurrency() << endl
+        << LOG_INFO << "SIMD           : " << HardwareProbe::getSIMDName(hw.simd_) << endl
+        << LOG_INFO << "GP kernels     : " << HardwareProbe::getSIMDName(OpKernels::getLevel()) << endl
+        << LOG_INFO << "L1d cache (KiB): " << (hw.l1dBytes_ >> 10)          << endl
+        << LOG_INFO << "L2 cache (KiB) : " << (hw.l2Bytes_  >> 10)          << endl
+        << LOG_INFO << "L3 cache (KiB) : " << (hw.l3Bytes_  >> 10)          << endl
+        << LOG_INFO << "NUMA nodes     : " << hw.numaNodes_                 << endl
+        << LOG_INFO << "Memory (MiB)   : " << (hw.memTotalBytes_ >> 20)     << endl
+        << LOG_INFO << "Available (MiB): " << (hw.memAvailBytes_ >> 20)     << endl
         << LOG_INFO << "g++ (GCC)      : " << __VERSION__                    << endl
         << LOG_INFO << "Boost          : " << BOOST_LIB_VERSION              << endl
         << LOG_INFO << "INT_MAX        : " << INT_MAX                        << endl
@@ -466,7 +604,36 @@ static void showSystem(ostream& out)
         << LOG_INFO << "World size     : " << sizeof(World)                  << endl
         << LOG_INFO << "Individual size: " << sizeof(Individual)             << endl
         << LOG_INFO << "Attribute size : " << sizeof(Attribute)              << endl
-        << LOG_INFO << "Allele size    : " << sizeof(Allele)                 << endl;
+        << LOG_INFO << "Allele size    : " << sizeof(Allele)                 << endl
+        << LOG_INFO << "GeneTree node  : " << sizeof(GeneTree::Node)         << endl
+
+        // Live footprint (mostly interesting after a job has run)
+        << LOG_INFO << "Live nodes     : " << MemStats::getLive(MemStats::ALLELE)          << endl
+        << LOG_INFO << "Live constants : " << MemStats::getLive(MemStats::CONST_ALLELE)    << endl
+        << LOG_INFO << "Live functions : " << MemStats::getLive(MemStats::FUNC_ALLELE)     << endl
+        << LOG_INFO << "Live lookups   : " << MemStats::getLive(MemStats::LOOKUP_ALLELE)   << endl
+        << LOG_INFO << "Live individs  : " << MemStats::getLive(MemStats::INDIVIDUAL)      << endl
+        << LOG_INFO << "Live genetrees : " << MemStats::getLive(MemStats::GENE_TREE)       << endl
+        << LOG_INFO << "Live bytes     : " << MemStats::getLiveBytes()                     << endl
+        << LOG_INFO << "Peak bytes     : " << MemStats::getPeakBytes()                     << endl
+        << LOG_INFO << "Pool (consts)  : " << MemStats::getPoolBlocks(MemStats::CONST_ALLELE_POOL)
+                    << " out, high-water " << MemStats::getPoolHighWater(MemStats::CONST_ALLELE_POOL) << endl
+        << LOG_INFO << "Pool (indivs)  : " << MemStats::getPoolBlocks(MemStats::INDIVIDUAL_POOL)
+                    << " out, high-water " << MemStats::getPoolHighWater(MemStats::INDIVIDUAL_POOL)   << endl;
+
+    // Calibrate the engine for this node
+    Tuning tuning = Tuning::calibrate(hw, out);
+    string path   = Tuning::pathFor();
+
+    out << LOG_INFO << "Tuning         : " << tuning << endl;
+    if(tuning.save(path))
+    {
+        out << LOG_NOTICE << "Tuning saved to " << path << endl;
+    }
+    else
+    {
+        out << LOG_WARN << "Cannot save tuning to " << path << endl;
+    }
 }
 
 // --------------------------------------------------------------------------
@@ -515,6 +682,175 @@ static int runTest(int testNum, ostream& out)
 }
 
 
+// --------------------------------------------------------------------------
+// writePerf:
+// --------------------------------------------------------------------------
+/**
+ * Writes a set of hardware counter readings as a JSON object
+ *
+ * @param json      Writer, ready for a value
+ * @param perf      Counts to write
+ */
+// --------------------------------------------------------------------------
+static void writePerf(JsonWriter& json, const PerfCounters::Sample& perf)
+{
+    json.beginObject();
+    for(int e = 0; e < PerfCounters::NUM_EVENTS; ++e)
+    {
+        json.field(PerfCounters::getEventName((PerfCounters::Event) e), perf.counts_[e]);
+    }
+    json.field("ipc", perf.getIPC())
+        .endObject();
+}
+
+
+// --------------------------------------------------------------------------
+// runBench:
+// --------------------------------------------------------------------------
+/**
+ * Runs a pre-packaged test as an end-to-end benchmark, reporting the work
+ * rates for each run as JSON.  Every run has fixed seeds (the configured
+ * seeds48, with the last one bumped per run), so two builds benchmarked
+ * this way evolve the same populations.  Population size, generations and
+ * threads come from the config file, and --set varies them per benchmark.
+ *
+ * @param testNum   Test number to run (see runTest)
+ * @param numRuns   Number of seeded runs
+ * @param out       Output stream for logging
+ *
+ * @return          EXIT_SUCCESS if every run passed its test
+ */
+// --------------------------------------------------------------------------
+static int runBench(int testNum, int numRuns, ostream& out)
+{
+    using namespace boost;
+    using Clock = chrono::steady_clock;
+
+    unsigned short seeds[3] = { 1, 2, 3 };
+    vector<string> cfgSeeds;
+    string         text;
+    char           hostName[64];
+    int            rc = EXIT_SUCCESS;
+
+    if(!CFG_SEEDS_48.empty())
+    {
+        split(cfgSeeds, CFG_SEEDS_48, is_any_of(", "), token_compress_on);
+        for(size_t i = 0; (i < cfgSeeds.size()) && (i < 3); ++i)
+        {
+            seeds[i] = lexical_cast<unsigned short>(cfgSeeds[i]);
+        }
+    }
+    gethostname(hostName, sizeof(hostName));
+    hostName[sizeof(hostName)-1] = '\0';
+
+    auto json = CFG_BENCH_JSON.empty() ? make_unique<JsonWriter>(text)
+                                       : make_unique<JsonWriter>(CFG_BENCH_JSON);
+    json->beginObject()
+            .field("version", APP_VERSION)
+            .field("host",    hostName)
+            .field("test",    testNum)
+            .key("runs").beginArray();
+
+    for(int run = 0; run < numRuns; ++run)
+    {
+        unsigned short runSeeds[3] = { seeds[0], seeds[1], (unsigned short) (seeds[2] + run) };
+        struct rusage  before;
+        struct rusage  after;
+
+        // Phase times (and hardware counts with --perf) for the run
+        Telemetry         telemetry("bench." + to_string(testNum));
+        Telemetry::Active activeTelemetry(telemetry);
+        auto&             perfCounters = PerfCounters::forThisThread();
+
+        seed48(runSeeds);
+        getrusage(RUSAGE_SELF, &before);
+        EvoStats::reset(CFG_BENCH_TARGET);
+        MemStats::resetPeak();
+
+        auto   perf   = perfCounters.read();            // Start counts; the run's after
+        auto   start  = Clock::now();
+        int    testRC = runTest(testNum, out);
+        double secs   = chrono::duration<double>(Clock::now() - start).count();
+        auto   stats  = EvoStats::snapshot();
+
+        getrusage(RUSAGE_SELF, &after);
+
+        auto perfEnd = perfCounters.read();
+        perf = (perfEnd -= perf);
+
+        double cpuSecs = (after.ru_utime.tv_sec  - before.ru_utime.tv_sec)
+                       + (after.ru_stime.tv_sec  - before.ru_stime.tv_sec)
+                       + (after.ru_utime.tv_usec - before.ru_utime.tv_usec) / 1e6
+                       + (after.ru_stime.tv_usec - before.ru_stime.tv_usec) / 1e6;
+
+        u_int numGens = telemetry.getNumGenerations();
+
+        out << LOG_INFO << "BENCH run " << run << ": " << secs << "s, "
+                        << numGens << " generations, "
+                        << stats.evaluations_ << " evaluations" << endl;
+
+        json->beginObject()
+                .field("seeds48",         to_string(runSeeds[0]) + "," +
+                                          to_string(runSeeds[1]) + "," +
+                                          to_string(runSeeds[2]))
+                .field("passed",          EXIT_SUCCESS == testRC)
+                .field("wall_secs",       secs)
+                .field("cpu_secs",        cpuSecs)
+                .field("evaluations",     stats.evaluations_)
+                .field("tree_evals",      stats.treeEvals_)
+                .field("nodes_evaluated", stats.nodesEvaluated_)
+                .field("evals_per_sec",   stats.evaluations_    / secs)
+                .field("nodes_per_sec",   stats.nodesEvaluated_ / secs)
+                .field("best_fitness",    stats.bestFitness_)
+                .field("peak_bytes",      MemStats::getPeakBytes())
+                .key("secs_to_target");
+        if(stats.secsToTarget_ < 0.0)   json->null();
+        else                            json->value(stats.secsToTarget_);
+
+        // Generations are counted by Telemetry::endGeneration(), so a World
+        // that doesn't report them gets null rather than a rate of zero
+        json->key("generations");
+        if(numGens)                     json->value(numGens);
+        else                            json->null();
+        json->key("gens_per_sec");
+        if(numGens)                     json->value(numGens / secs);
+        else                            json->null();
+
+        if(Telemetry::isPerf())
+        {
+            // Whole run on the main thread, then each phase across all threads
+            json->key("perf");
+            writePerf(*json, perf);
+
+            json->key("phases").beginObject();
+            for(int p = 0; p < Telemetry::NUM_PHASES; ++p)
+            {
+                auto phase = (Telemetry::Phase) p;
+
+                json->key(Telemetry::getPhaseName(phase));
+                writePerf(*json, telemetry.getPhasePerf(phase));
+            }
+            json->endObject();
+        }
+        json->endObject();
+
+        if(EXIT_SUCCESS != testRC)
+        {
+            rc = testRC;
+        }
+    }
+    json->endArray()
+         .endObject()
+         .commit();
+
+    if(CFG_BENCH_JSON.empty())
+    {
+        out << LOG_NOTICE << "BENCH " << trim_copy(text) << endl;
+    }
+    return rc;
+}
+
+
 // --------------------------------------------------------------------------
 // serveJobs:
 // --------------------------------------------------------------------------
@@ -558,7 +894,7 @@ static void serveJobs(MPI_Communicator& mpiComm, ToDoQueue::JobCode endCode, ost
 
     // Prepare end-of-work text code
     const char *endCodeText = ToDoQueue::jobCodeText(endCode);
-    out << LOG_DEBUG << "Serving " << ToDos->size() << " tasks: end[" << endCodeText << ']' << endl;
+    ALOG_DEBUG(*ALog, "Serving ", ToDos->size(), " tasks: end[", endCodeText, ']');
 
     // Check to see if this is still the case and convert to non-blocking
     while(!allDone)
@@ -578,7 +914,7 @@ static void serveJobs(MPI_Communicator& mpiComm, ToDoQueue::JobCode endCode, ost
 
                 // It's in!
                 waiting = false;
-                out << LOG_DEBUG << "Received task request from MPI-" << source << endl;
+                ALOG_DEBUG(*ALog, "Received task request from MPI-", source);
 
                 // They should sent their last job, which we don't care about,
                 // except to know that it's not an exit/error code.
@@ -591,11 +927,11 @@ static void serveJobs(MPI_Communicator& mpiComm, ToDoQueue::JobCode endCode, ost
                     job = ToDos->getTask(endCode);
                     if(job >= 0)
                     {
-                        out << LOG_INFO << "Assigning job #" << job << " to MPI-" << source << endl;
+                        ALOG_INFO(*ALog, "Assigning job #", job, " to MPI-", source);
                     }
                     else if (endCode == job)
                     {
-                        out << LOG_INFO << "Returning " << endCodeText << " to MPI-" << source << endl;
+                        ALOG_INFO(*ALog, "Returning ", endCodeText, " to MPI-", source);
                         nodesDone[source] = true;
                     }
                     else
@@ -634,17 +970,17 @@ static void serveJobs(MPI_Communicator& mpiComm, ToDoQueue::JobCode endCode, ost
                     if(i == lastNode)
                     {
                         allDone = true;
-                        out << LOG_DEBUG << "Work complete for all MPI nodes" << endl;
+                        ALOG_DEBUG(*ALog, "Work complete for all MPI nodes");
                     }
                 }
                 else
                 {
-                    out << LOG_DEBUG << "MPI-" << i << " is still computing" << endl;
+                    ALOG_DEBUG(*ALog, "MPI-", i, " is still computing");
                     break;
                 }
             }
         }
-        else out << LOG_DEBUG << "Continuing job service" << endl;
+        else ALOG_DEBUG(*ALog, "Continuing job service");
     }
 #endif // ENABLE_MPI
 }
@@ -805,6 +1141,8 @@ static int getNextJob(MPI_Communicator& mpiComm, int lastJob, ostream& out)
  * Selects the best models to use as Genetic Programming travelling Individuals.
  * The models are selected by fitness according to the specified criteria.
  *
+ * @tparam DB         Delphi backend: Delphi or DelphiFile
+ *
  * @param db          Delphi database object
  * @param symbol      Model works for this Stock symbol
  * @param fnName      The functional (short) name for the model's target attribute,
@@ -816,7 +1154,8 @@ static int getNextJob(MPI_Communicator& mpiComm, int lastJob, ostream& out)
  * @return            The number of travellers retrieved from the database
  */
 // --------------------------------------------------------------------------
-static int pullTravellers(Delphi&                     db,
+template<class DB>
+static int pullTravellers(DB&                         db,
                           const string&               symbol,
                           const string&               fnName,
                           size_t                      days,
@@ -857,6 +1196,309 @@ static int pullTravellers(Delphi&                     db,
 }
 
 
+// --------------------------------------------------------------------------
+// runJob:
+// --------------------------------------------------------------------------
+/**
+ * Evolves a model for one ProgJob on the current security's price data and
+ * (unless we're discrete) saves the winner to Delphi.
+ *
+ * @tparam DB       Delphi backend: Delphi or DelphiFile
+ *
+ * @param job       Index of the job in the environment's job list
+ * @param env       Job environment for this process
+ * @param symbol    Stock symbol for the current security
+ * @param tradeDate Last trading day in the price data (ISO format)
+ * @param out       Output stream for logging
+ *
+ * @return          EXIT_SUCCESS once the job is complete
+ */
+// --------------------------------------------------------------------------
+template<class DB>
+static int runJob(int               job,
+                  const JobEnv<DB>& env,
+                  const string&     symbol,
+                  const string&     tradeDate,
+                  ostream&          out)
+{
+    const ProgJob&    progJob   = env.jobs_[job];
+    vector<Traveller> travellers;
+    string            daysText  = boost::lexical_cast<string>(progJob.days_);
+    string            name      = symbol        + "." +
+                                  progJob.name_ + "." +
+                                  daysText;
+
+    // Main job type is arbitrary, but CLOSE is a logical choice
+    bool isMainJob = (env.jobs_.size() == 1) ||
+                     (progJob.name_ == ProgJob::CLOSE);
+
+    // Take a break before we do anything if the node needs one
+    if(!env.isEager_)
+    {
+        env.governor_.pace(out);
+    }
+    out << LOG_NOTICE << "JOB #" << job
+                       <<   " ["  << name
+                       <<  "] @ NOW" << endl;
+
+    // Set up for evolution
+    auto  world      = make_unique<PriceWorld>(name, tradeDate, out);
+    auto& targetCode = world->configureJob(progJob, env.priceData_, CFG_DAYS_IN_WIN);
+
+    world->setMPICommunicator(&env.mpiComm_);
+
+    if(pullTravellers(*env.db_,
+                      symbol,
+                      targetCode,
+                      progJob.days_,
+                      travellers,
+                      out) > 0)
+    {
+        world->readyTravellers(travellers);
+    }
+
+    // go, Go, GO...!!  (Telemetry collects per-generation metrics for the job)
+    Telemetry         telemetry(name, CFG_TELEMETRY_CSV.empty() ? ""
+                                                                : CFG_TELEMETRY_CSV + "/" + name + ".csv");
+    Telemetry::Active activeTelemetry(telemetry);
+    CPUClock          cpuClock;
+
+    MemStats::resetPeak();
+    world->createPopulation();
+    world->evolve();
+
+    // Guess the future, but write full JSON data only when working a CLOSE
+    world->prognosticate(isMainJob);
+
+    // Shall we save a copy of the winner to the database?  The writer thread
+    // takes care of it so we don't sit waiting on the DB host.
+    if (!env.isDiscrete_)
+    {
+        string symbolCode = symbol;
+        string modelCode  = targetCode;
+        size_t days       = progJob.days_;
+        auto   fitness    = world->getBestFitness();
+        auto   prophecy   = world->prophesy(true);
+        auto   solution   = world->getBestSolution();
+        auto   cpuTime    = world->getCPUTime();
+        auto   wallSecs   = world->getWallSecs();
+
+        env.writer_->post([=](DB& db, ostream& log)
+                          {
+                              db.addModel(symbolCode,
+                                          modelCode,
+                                          days,
+                                          MODEL_CODE,
+                                          tradeDate,
+                                          fitness,
+                                          prophecy,
+                                          solution,
+                                          cpuTime,
+                                          wallSecs,
+                                          CFG_USE_XSEC_GLD,
+                                          log);
+                          },
+                          out);
+    }
+
+    out << LOG_INFO << "  TIME:  "  << cpuClock  << endl
+        << LOG_INFO << "  PHASE: "  << telemetry << endl
+        << LOG_INFO << "  MEM:   "  << MemStats::getPeakBytes() << " peak bytes, "
+                                    << MemStats::getLive(MemStats::ALLELE) << " live nodes" << endl;
+
+    if(Telemetry::isPerf())
+    {
+        for(int p = 0; p < Telemetry::NUM_PHASES; ++p)
+        {
+            auto phase = (Telemetry::Phase) p;
+            auto perf  = telemetry.getPhasePerf(phase);
+
+            out << LOG_INFO << "  PERF:  "  << Telemetry::getPhaseName(phase)
+                            << ": "         << perf.counts_[PerfCounters::CYCLES]        << " cycles, "
+                                            << perf.counts_[PerfCounters::INSTRUCTIONS]  << " instructions, "
+                                            << perf.getIPC()                              << " IPC, "
+                                            << perf.counts_[PerfCounters::LLC_MISSES]    << " LLC misses, "
+                                            << perf.counts_[PerfCounters::BRANCH_MISSES] << " branch misses"
+                                            << endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+// --------------------------------------------------------------------------
+// isLaunchedAlone:
+// --------------------------------------------------------------------------
+/**
+ * Returns true if no MPI launcher started us alongside other ranks.  We ask
+ * before MPI_Init (so we can still fork), which means asking the launcher's
+ * environment rather than MPI itself.
+ */
+// --------------------------------------------------------------------------
+static bool isLaunchedAlone()
+{
+    for(auto var : { "OMPI_COMM_WORLD_SIZE", "PMI_SIZE", "PMIX_SIZE" })     // OpenMPI, MPICH/Slurm, PMIx
+    {
+        const char *size = getenv(var);
+
+        if(size && (atoi(size) > 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// --------------------------------------------------------------------------
+// getOwnLoad:
+// --------------------------------------------------------------------------
+/**
+ * Returns the load Sibyl herself puts on this node: the jobs running here
+ * (loner workers, or the MPI ranks on this host) times the evaluation
+ * threads each one runs.  The PacingGovernor takes this off the load
+ * average, so we only pause for other work.
+ */
+// --------------------------------------------------------------------------
+static double getOwnLoad()
+{
+    int         jobsHere  = 1;
+    const char *localSize = getenv("OMPI_COMM_WORLD_LOCAL_SIZE");   // Ranks on this host (OpenMPI)
+
+    if(IsLoner)
+    {
+        jobsHere = max(1, CFG_LONER_JOBS);
+    }
+    else if(localSize)
+    {
+        jobsHere = max(1, atoi(localSize));
+    }
+    return (double) jobsHere * Tuning::get().getThreads();
+}
+
+
+// --------------------------------------------------------------------------
+// forkLonerCrew:
+// --------------------------------------------------------------------------
+/**
+ * Forks CFG_LONER_JOBS workers when we are the only node running.  Each
+ * worker goes on to run Sibyl as a loner of its own, with its own log, RNG
+ * stream, Delphi connection and price data, and claims the jobs for each
+ * security from the rest of the crew (see claimLonerJob).  The parent just
+ * waits for the crew.
+ *
+ * We fork rather than thread because the GP engine draws on the (global)
+ * rand48 state and each World already runs its own fitness threads.  We fork
+ * first thing, before MPI_Init and before any thread (logger, Delphi writer)
+ * starts, since neither MPI nor a running thread survives a fork.
+ *
+ * If no worker can be started, the parent does the work itself.
+ *
+ * @param rc        Output: in the parent, EXIT_SUCCESS if the whole crew
+ *                  completed successfully, EXIT_FAILURE otherwise
+ *
+ * @return          true in a worker (or a parent with no crew), which should
+ *                  go on and run; false in a parent whose crew is done
+ */
+// --------------------------------------------------------------------------
+static bool forkLonerCrew(int& rc)
+{
+    void *claims = mmap(NULL, sizeof(atomic<uint64_t>), PROT_READ | PROT_WRITE,
+                                                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(MAP_FAILED == claims)
+    {
+        throw Exception("Cannot share the loner job claims", errno);
+    }
+    LonerClaims = new(claims) atomic<uint64_t>(0);
+
+    vector<pid_t> crew;
+
+    rc = EXIT_SUCCESS;
+    for(int w = 0; w < CFG_LONER_JOBS; ++w)
+    {
+        pid_t pid = fork();
+
+        if(0 == pid)
+        {
+            LonerWorker = w;
+            return true;
+        }
+        else if(pid > 0)
+        {
+            crew.push_back(pid);
+        }
+        else
+        {
+            cerr << "Cannot fork loner worker #" << w << ": " << strerror(errno) << endl;
+            rc = EXIT_FAILURE;
+        }
+    }
+
+    // If we couldn't start anyone, we'll have to do the work ourselves
+    if(crew.empty())
+    {
+        LonerWorker = 0;
+        return true;
+    }
+
+    for(pid_t pid : crew)
+    {
+        int status = 0;
+
+        if((waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || (EXIT_SUCCESS != WEXITSTATUS(status)))
+        {
+            cerr << "Loner worker [" << pid << "] failed: status[" << status << ']' << endl;
+            rc = EXIT_FAILURE;
+        }
+    }
+    return false;
+}
+
+
+// --------------------------------------------------------------------------
+// claimLonerJob:
+// --------------------------------------------------------------------------
+/**
+ * Claims the next unworked job of a round for this loner worker.  A round
+ * is one security on one day, numbered the same way by every worker, since
+ * they all walk the same securities.  The shared claim word holds the
+ * latest round anyone has reached (high 40 bits) and its next job (low 24).
+ *
+ * A worker only moves the word on to a later round once it finds the
+ * current one used up, so a worker that finds a later round in the word
+ * has nothing left to do in its own.
+ *
+ * @param round     This worker's round
+ * @param numJobs   Jobs per round
+ *
+ * @return          The job number, or -1 if the round's jobs are all taken
+ */
+// --------------------------------------------------------------------------
+static int claimLonerJob(uint64_t round, int numJobs)
+{
+    static const int JOB_BITS = 24;
+
+    assert(LonerClaims);
+    uint64_t claim = LonerClaims->load();
+
+    for(;;)
+    {
+        uint64_t claimRound = claim >> JOB_BITS;
+        int      job        = (claimRound == round) ? (int) (claim & ((1 << JOB_BITS) - 1)) : 0;
+
+        if((claimRound > round) || (job >= numJobs))
+        {
+            return -1;
+        }
+        if(LonerClaims->compare_exchange_weak(claim, (round << JOB_BITS) | (job + 1)))
+        {
+            return job;
+        }
+    }
+}
+
+
 /*/- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- -=- **\*/
 // ⡀⣀ ⡀⢀ ⣀⡀
 // ⠏  ⠣⠼ ⠇⠸
@@ -866,26 +1508,33 @@ static int pullTravellers(Delphi&                     db,
  * other node(s), doing no real work itself.  The intent is that this node-0
  * be the head node on a Beowulf system.
  *
+ * @tparam DB       Delphi backend: Delphi, or DelphiFile for offline runs
+ *
  * @param cfg       Sibyl configuration (INI and CLI options)
  * @param mpiComm   MPI Communicator object (MPI COMM World)
  * @param out       Output stream for logging
  *
  * @return          Return code from run
  *///-------------------------------------------------------------------------
+template<class DB>
 static int run(ConfMap& cfg, MPI_Communicator& mpiComm, std::ostream& out)
 {
-    int  rc             = EXIT_FAILURE;
-    int  errCnt         = 0;
+    int     rc          = EXIT_FAILURE;
+    int     errCnt      = 0;
+    u_long  dayNum      = 0;
 
     HumanClock        scheduler(&cfg);
-    Delphi            db(CFG_DB_HOST, CFG_DB_USER);
+    PacingGovernor    governor(CFG_PACE_LOAD, CFG_PACE_TEMP, getOwnLoad());
+    DB                db(DelphiSource, CFG_DB_USER);
     PriceDataPack     priceData(out);
-    vector<Traveller> travellers;
     vector<ProgJob>   jobs;
     int               numJobs    = 0;
     bool              isMaster   = (!IsLoner && (0 == mpiComm.rank()));
-    bool              isDiscrete = isConfigured(cfg, "discrete");
-    bool              isEager    = isConfigured(cfg, "eager");
+
+    DelphiWriter<DB>  writer(DelphiSource, CFG_DB_USER);
+    JobEnv<DB>        env        = { jobs, scheduler, governor, &db, &writer, priceData, mpiComm,
+                                     isConfigured(cfg, "discrete"),
+                                     isConfigured(cfg, "eager") };
 
     // Pull job list from the INI file
     if(cfg.count("prog-jobs"))
@@ -916,9 +1565,10 @@ static int run(ConfMap& cfg, MPI_Communicator& mpiComm, std::ostream& out)
         out << LOG_NOTICE << "Sibyl ACTIVE for delphi @ " << scheduler.getStartInfo() << endl;
 
         // Run through today's securities
-        const SecurityPack& secPack =  db.getSecurities(true, CFG_SECURITIES);
+        const auto& secPack = db.getSecurities(true, CFG_SECURITIES);
+        u_int       secNum  = 0;
 
-        for(auto sec = secPack.begin(); sec != secPack.end(); ++sec)
+        for(auto sec = secPack.begin(); sec != secPack.end(); ++sec, ++secNum)
         {
             // Every time, assume the worst...
             rc = EXIT_FAILURE;
@@ -929,12 +1579,11 @@ static int run(ConfMap& cfg, MPI_Communicator& mpiComm, std::ostream& out)
             // Enough data to build a model??
             if(numRecs > CFG_DAYS_IN_WIN)
             {
-                out << LOG_DEBUG
-                    << "GP World[" << sec->symbol_
-                    << "] with "   << numRecs << " days of data!" << endl;
+                ALOG_DEBUG(*ALog, "GP World[", sec->symbol_, "] with ", numRecs, " days of data!");
 
                 // Run all (my) jobs for this security's data...
-                int job = initJobList(isMaster, numJobs, out);
+                int    job       = initJobList(isMaster, numJobs, out);
+                string tradeDate = dts::to_iso_string(sec->lastUpdate_);
 
                 if(isMaster)
                 {
@@ -942,81 +1591,25 @@ static int run(ConfMap& cfg, MPI_Communicator& mpiComm, std::ostream& out)
                     serveJobs(mpiComm, ToDoQueue::SYNC, out);   // Tell 'em all what to do
                     serveJobs(mpiComm, ToDoQueue::DONE, out);   // Tell 'em all it's done!
                 }
-                else while((job = getNextJob(mpiComm, job, out)) >= 0)
+                else if(LonerClaims)
                 {
-                    string daysText  = boost::lexical_cast<string>(jobs[job].days_);
-                    string name      = sec->symbol_    + "." +
-                                       jobs[job].name_ + "." +
-                                       daysText;
-                    string tradeDate = dts::to_iso_string(sec->lastUpdate_);
-
-                    // Main job type is arbitrary, but CLOSE is a logical choice
-                    bool isMainJob = (numJobs == 1) ||
-                                     (jobs[job].name_ == ProgJob::CLOSE);
-
-                    // Take a nap before we do anything if we need to:
-                    out << LOG_NOTICE << "JOB #" << job
-                                       <<   " ["  << name
-                                       <<  "] @ ";
-                    if(isEager)
-                        out << "NOW" << endl;
-                    else
-                    {
-                        out << scheduler << endl;
-                        usleep(scheduler++);
-                    }
+                    // Single box: share the jobs with the rest of the loner crew
+                    uint64_t round = (dayNum << 16) | secNum;
 
-                    // Set up for evolution
-                    auto  world      = make_unique<PriceWorld>(name, tradeDate, out);
-                    auto& targetCode = world->configureJob(jobs[job], priceData, CFG_DAYS_IN_WIN);
-
-                    world->setMPICommunicator(&mpiComm);
-                    
-                    if(pullTravellers(db,
-                                      sec->symbol_,
-                                      targetCode,
-                                      jobs[job].days_,
-                                      travellers,
-                                      out) > 0)
-                    {
-                        world->readyTravellers(travellers);
-                    }
-
-                    // go, Go, GO...!!
-                    CPUClock cpuClock;
-                    world->createPopulation();
-                    world->evolve();
-
-                    // Guess the future, but write full JSON data only when working a CLOSE
-                    world->prognosticate(isMainJob);
-
-                    // Shall we save a copy of the winner to the database
-                    if (!isDiscrete)    db.addModel(sec->symbol_,
-                                                    targetCode,
-                                                    jobs[job].days_,
-                                                    MODEL_CODE,
-                                                    tradeDate,
-                                                    world->getBestFitness(),
-                                                    world->prophesy(true),
-                                                    world->getBestSolution(),
-                                                    world->getCPUTime(),
-                                                    world->getWallSecs(),
-                                                    CFG_USE_XSEC_GLD,
-                                                    out);
-
-                    out << LOG_INFO << "  TIME:  "  << cpuClock << endl;
-
-                    // Give the CPU a break before we ask for more work
-                    if(!isEager)
+                    rc = EXIT_SUCCESS;
+                    while((job = claimLonerJob(round, numJobs)) >= 0)
                     {
-                        out << LOG_INFO << "End of job cool down...(whew!)" << endl;
-                        sleep(2 * 60);
+                        if(runJob(job, env, sec->symbol_, tradeDate, out) != EXIT_SUCCESS)
+                        {
+                            rc = EXIT_FAILURE;
+                        }
                     }
-
+                }
+                else while((job = getNextJob(mpiComm, job, out)) >= 0)
+                {
                     // If this is the last one, it was good!
-                    rc = EXIT_SUCCESS;
-
-                } //else-while(job)
+                    rc = runJob(job, env, sec->symbol_, tradeDate, out);
+                }
 
                 // Indicate we're done
                 shutdownJobList(isMaster, out);
@@ -1031,8 +1624,13 @@ static int run(ConfMap& cfg, MPI_Communicator& mpiComm, std::ostream& out)
 
 
         // All done until tomorrow!
+        if(writer.flush(out, true) > 0)
+        {
+            out << LOG_ERR << "Some models could not be saved to delphi" << endl;
+        }
         db.deactivate();
         scheduler.endDay();
+        ++dayNum;
 
         // Did they request NO-LOOP mode??
         if(isConfigured(cfg, "once"))
@@ -1083,20 +1681,6 @@ int main(int argc, char** argv)
 
     try
     {
-        // Setup for MPI parallel processing
-        MPI_Environment  mpiEnv(argc, argv);
-        MPI_Communicator mpiWorld;
-
-        // Who are we in this big MPI world?
-        u_int rank     = mpiWorld.rank();
-        u_int numNodes = mpiWorld.size();
-        char  hostName[64];
-
-        gethostname(hostName, sizeof(hostName));
-        hostName[sizeof(hostName)-1] = '\0';
-
-        IsLoner  = (1 == numNodes);
-
         // Handle CLI and INI config options...
         ini::variables_map       cfg;
         ini::options_description cfgDescr("Sibyl options");
@@ -1107,46 +1691,118 @@ int main(int argc, char** argv)
         configure<string>(cfg, "log-stub",         CFG_LOG_FILESTUB);
         configure<string>(cfg, "db-host",          CFG_DB_HOST);
         configure<string>(cfg, "db-user",          CFG_DB_USER);
+        configure<string>(cfg, "delphi-dir",       CFG_DELPHI_DIR);
         configure<string>(cfg, "insert-best-gens", CFG_INSERT_BEST_GENS);
         configure<string>(cfg, "securities",       CFG_SECURITIES);
         configure<string>(cfg, "seeds48",          CFG_SEEDS_48);
+        configure<string>(cfg, "simd",             CFG_SIMD);
+        configure<string>(cfg, "bench-json",       CFG_BENCH_JSON);
+        configure<string>(cfg, "telemetry-csv",    CFG_TELEMETRY_CSV);
 
         configure<int>(cfg, "test",         CFG_RUN_TEST);
+        configure<int>(cfg, "bench",        CFG_BENCH_RUNS);
         configure<int>(cfg, "master-node",  CFG_MASTER_NODE);
         configure<int>(cfg, "max-errors",   CFG_MAX_ERRORS);
         configure<int>(cfg, "days-to-pull", CFG_DAYS_TO_PULL);
         configure<int>(cfg, "days-in-win",  CFG_DAYS_IN_WIN);
+        configure<int>(cfg, "loner-jobs",   CFG_LONER_JOBS);
 
+        configure<double>(cfg, "bench-target", CFG_BENCH_TARGET);
+        configure<double>(cfg, "pace-load",    CFG_PACE_LOAD);
+        configure<double>(cfg, "pace-temp",    CFG_PACE_TEMP);
+
+        CFG_PERF         = cfg.count("perf");
         CFG_USE_XSEC_DIA = cfg.count("use-xsec-dia");
         CFG_USE_XSEC_GLD = cfg.count("use-xsec-gld");
 #if ENABLE_CUDA
         CFG_MIRROR_GPU   = cfg.count("mirror-gpu");
 #endif
 
+        // A lone node running several jobs forks its crew now, before MPI
+        // or any thread starts.  The parent only waits on the crew.
+        if((CFG_RUN_TEST < 0) && (CFG_LONER_JOBS > 1) && isLaunchedAlone() && !forkLonerCrew(rc))
+        {
+            return rc;
+        }
+
+        // Setup for MPI parallel processing
+        MPI_Environment  mpiEnv(argc, argv);
+        MPI_Communicator mpiWorld;
+
+        // Who are we in this big MPI world?
+        u_int rank     = mpiWorld.rank();
+        u_int numNodes = mpiWorld.size();
+        char  hostName[64];
+
+        gethostname(hostName, sizeof(hostName));
+        hostName[sizeof(hostName)-1] = '\0';
+
+        IsLoner  = (1 == numNodes);
+
+        DelphiSource = CFG_DELPHI_DIR.empty() ? CFG_DB_HOST
+                                              : CFG_DELPHI_DIR;
+
         // Prepare a log file if they have requested one
         if(!CFG_LOG_FILESTUB.empty())
         {
             logPtr = new Logger(CFG_LOG_FILESTUB + "." +
-                                B::lexical_cast<std::string>(rank));
+                                B::lexical_cast<std::string>(rank) +
+                                ((LonerWorker >= 0) ? "." + B::lexical_cast<std::string>(LonerWorker) : ""));
         }
 
-        // Logging works from here on:
-        ostream& log = (logPtr) ? *logPtr
-                                :  cout;
-        log.setf(ios::fixed);
-        log.setf(ios::showpoint);
-        log.precision(4);
+        // Logging works from here on.  Only the AsyncLog's flusher writes to the sink.
+        ostream& sink = (logPtr) ? *logPtr
+                                 :  cout;
+        sink.setf(ios::fixed);
+        sink.setf(ios::showpoint);
+        sink.precision(4);
+
+        ALog = new AsyncLog(sink);
+        ostream& log = ALog->stream();
         log << LOG_NOTICE << "Welcome to Sibyl: v"  << APP_VERSION                                  << endl
             << LOG_NOTICE << "CFG { " << CFG_CFG_FILEPATH                                   << " }" << endl
-            << LOG_NOTICE << "MPI { " << rank << ":" << mpiWorld.size() << ":" << hostName  << " }" << endl;
+            << LOG_NOTICE << "MPI { " << rank << ":" << mpiWorld.size() << ":" << hostName  << " }" << endl
+            << LOG_NOTICE << "TUN { " << Tuning::get()                                  << " }" << endl;
         if(!IsLoner && (0 == rank))
         {
             log << LOG_NOTICE << "Node acting as MPI master" << endl;
         }
+        if(LonerWorker >= 0)
+        {
+            log << LOG_NOTICE << "Loner worker #" << LonerWorker << " of " << CFG_LONER_JOBS << endl;
+        }
         
         // Genetic Programming needs lots of randomness
         initRand48(log);
 
+        // Holding the GP kernels to a lower SIMD level?
+        if(!CFG_SIMD.empty())
+        {
+            int level = HardwareProbe::NUM_SIMDS;
+
+            while((--level >= 0) && (CFG_SIMD != HardwareProbe::getSIMDName((HardwareProbe::SIMD) level)))
+            {
+                // Looking for the level by name
+            }
+            if(level < 0)
+            {
+                throw Exception("Unknown SIMD level: " + CFG_SIMD, EINVAL);
+            }
+            OpKernels::select((HardwareProbe::SIMD) level);
+            log << LOG_NOTICE << "GP kernels held to " << HardwareProbe::getSIMDName(OpKernels::getLevel()) << endl;
+        }
+
+        // Profiling with the hardware counters?
+        if(CFG_PERF)
+        {
+            Telemetry::setPerf(true);
+            if(!PerfCounters::forThisThread().isOpen())
+            {
+                log << LOG_WARN << "Hardware counters unavailable (check perf_event_paranoid);"
+                                   " --perf readings will be zero" << endl;
+            }
+        }
+
         // Need hardware Info??
         if(cfg.count("system"))
         {
@@ -1156,8 +1812,11 @@ int main(int argc, char** argv)
         // MAIN BIT!
         //
         // go, Go, GO...!!
-        if(CFG_RUN_TEST >= 0)  rc = runTest(CFG_RUN_TEST, log);         // Pre-defined TEST
-        else                   rc = run(cfg, mpiWorld, log);            // The REAL THING
+        if((CFG_RUN_TEST >= 0) && CFG_BENCH_RUNS)
+                                        rc = runBench(CFG_RUN_TEST, CFG_BENCH_RUNS, log);   // TEST as benchmark
+        else if(CFG_RUN_TEST >= 0)      rc = runTest(CFG_RUN_TEST, log);            // Pre-defined TEST
+        else if(CFG_DELPHI_DIR.empty()) rc = run<Delphi>(cfg, mpiWorld, log);       // The REAL THING
+        else                            rc = run<DelphiFile>(cfg, mpiWorld, log);   // Offline/benchmark
     }
     catch(exception& e)
     {
@@ -1171,6 +1830,7 @@ int main(int argc, char** argv)
     }
 
     // Cleanup and go!
+    delete ALog;
     delete logPtr;
     exit(rc);
 }